@@ -0,0 +1,754 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <array>
+#include <memory>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <mpi.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "settings.h"
+#include "timekeeper.h"
+#include "discretization/partition_information.h"
+#include "discretization/central_differences.h"
+#include "discretization/donor_cell.h"
+#include "discretization/async_partition.h"
+#include "pressure_solver/sor.h"
+#include "pressure_solver/checkerboard.h"
+#include "pressure_solver/wavefront_sor.h"
+#include "pressure_solver/red_black_kernel.h"
+
+// setup with "cmake .. -DBENCHMARK=1", run with "numsim_3d <benchmark> [nCells per direction]"
+// the kernels are timed on the partitions of all ranks, the slowest rank is reported
+
+//! gives the benchmarks access to the steps of a pressure solver without its residuum checks
+template<typename Solver>
+class SweepTimer : public Solver
+{
+public:
+    using Solver::Solver;
+
+    //! runs nSteps steps with the halo set before each step like in solve, returns the time of the slowest rank
+    double timeSteps(int nSteps)
+    {
+        MPI_Barrier(MPI_COMM_WORLD);
+        const auto t0 = timestamp();
+        for(this->iteration_ = 0; this->iteration_ < nSteps; this->iteration_++)
+        {
+            if(!this->useOverlappedComm_ || !this->overlapsHaloOfP_)
+                this->partition_->setBoundaryP();
+            this->step();
+        }
+        double duration = getDurationS(t0);
+        MPI_Allreduce(MPI_IN_PLACE, &duration, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+        return duration;
+    }
+
+    //! the residuum of the partition without the reduction, as in calculateResiduum2
+    double partitionResiduum2() { return this->calculatePartitionResiduum2(); }
+};
+
+//! gives the halo benchmark access to the neighbours of a partition, so each direction is exchanged on its own
+class HaloTimer : public AsyncPartition
+{
+public:
+    using AsyncPartition::AsyncPartition;
+
+    //! number of neighbours in the direction axis
+    int nNeighbours(int axis) const
+    {
+        return std::count_if(asyncNeighbours_.begin(), asyncNeighbours_.end(),
+                             [axis](const std::shared_ptr<AsyncNeighbourBoundary> &neighbour) { return neighbour->axis() == axis; });
+    }
+
+    //! exchanges the faces of p or of u, v and w with the neighbours in the direction axis nExchanges times,
+    //! packed into the buffers or in place with the datatypes, returns the time of the slowest rank
+    double timeExchanges(int axis, bool inPlace, bool velocities, int nExchanges)
+    {
+        FieldVariable &p = discretization_->p();
+        std::vector<std::shared_ptr<AsyncNeighbourBoundary>> neighbours;
+        for(std::shared_ptr<AsyncNeighbourBoundary> neighbour : asyncNeighbours_)
+        {
+            if(neighbour->axis() != axis)
+                continue;
+            neighbour->createFaceTypes();
+            neighbours.push_back(neighbour);
+        }
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        const auto t0 = timestamp();
+        for(int e = 0; e < nExchanges; e++)
+        {
+            std::vector<std::shared_ptr<AsyncNeighbourBoundary>> neighbourRecvQueue;
+            for(std::shared_ptr<AsyncNeighbourBoundary> neighbour : neighbours)
+            {
+                neighbour->mpiHandler_.waitForSendComplete();
+                if(inPlace && velocities)
+                    neighbour->exchangeUVWInPlace();
+                else if(inPlace)
+                    neighbour->exchangeCellFieldInPlace(p);
+                else if(velocities)
+                    neighbour->exchangeUVW();
+                else
+                    neighbour->exchangeCellField(p);
+                neighbourRecvQueue.push_back(neighbour);
+            }
+            if(inPlace)
+            {
+                for(std::shared_ptr<AsyncNeighbourBoundary> neighbour : neighbours)
+                {
+                    neighbour->mpiHandler_.waitForRecvComplete();
+                    neighbour->mpiHandler_.waitForSendComplete();
+                }
+            }
+            else if(velocities)
+                setFirstIncomingData(neighbourRecvQueue, &AsyncNeighbourBoundary::setRecvUVW);
+            else
+                setFirstIncomingData(neighbourRecvQueue, &AsyncNeighbourBoundary::setRecvCellField, p);
+        }
+        for(std::shared_ptr<AsyncNeighbourBoundary> neighbour : neighbours)
+            neighbour->mpiHandler_.waitForSendComplete();
+        double duration = getDurationS(t0);
+        MPI_Allreduce(MPI_IN_PLACE, &duration, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+        return duration;
+    }
+};
+
+//! same partition setup as runComputation
+struct BenchmarkSetup
+{
+    BenchmarkSetup(int nCells, bool useDonorCell = false)
+    {
+        settings.useDonorCell = useDonorCell;
+        settings.nCells = {nCells, nCells, nCells};
+        std::array<double, 3> meshWidth{settings.physicalSize[0]/nCells, settings.physicalSize[1]/nCells,
+                                        settings.physicalSize[2]/nCells};
+        pi = std::make_shared<PartitionInformation>(settings.nCells, meshWidth, MPI_COMM_WORLD);
+        if(useDonorCell)
+            discretization = std::make_shared<DonorCell>(*pi, settings);
+        else
+            discretization = std::make_shared<CentralDifferences>(*pi, settings);
+        partition = std::make_shared<AsyncPartition>(discretization, settings, *pi);
+    }
+
+    //! the same pseudo random pressure and rhs for each kernel, so all of them do the same work
+    void resetPressure()
+    {
+        unsigned int seed = 12345 + pi->ownRankNo();
+        for(int k = 0; k < discretization->pkN(); k++)
+        {
+            for(int j = 0; j < discretization->pjN(); j++)
+            {
+                for(int i = 0; i < discretization->piN(); i++)
+                {
+                    seed = seed * 1103515245 + 12345;
+                    discretization->p(i,j,k) = (seed >> 16) / 65536.0;
+                    discretization->rhs(i,j,k) = 0.0;
+                }
+            }
+        }
+    }
+
+    //! pseudo random velocities including the ghost layers, so the convective terms of all cells are non-trivial
+    void resetVelocities()
+    {
+        unsigned int seed = 54321 + pi->ownRankNo();
+        for(FieldVariable *field : {&discretization->u(), &discretization->v(), &discretization->w()})
+        {
+            for(std::size_t n = 0; n < field->length(); n++)
+            {
+                seed = seed * 1103515245 + 12345;
+                field->data()[n] = (seed >> 16) / 32768.0 - 1.0;
+            }
+        }
+    }
+
+    //! time of one call of calculate on the slowest rank, averaged over nRepetitions calls
+    template<typename Calculate>
+    double timeRepetitions(int nRepetitions, Calculate calculate) const
+    {
+        MPI_Barrier(MPI_COMM_WORLD);
+        const auto t0 = timestamp();
+        for(int r = 0; r < nRepetitions; r++)
+            calculate();
+        double duration = getDurationS(t0) / nRepetitions;
+        MPI_Allreduce(MPI_IN_PLACE, &duration, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+        return duration;
+    }
+
+    //! largest deviation of the field from the reference on this rank, the reference has the length of the field
+    double deviationFrom(const std::vector<double> &reference, FieldVariable &field) const
+    {
+        double deviation = 0.0;
+        for(std::size_t c = 0; c < reference.size(); c++)
+            deviation = std::max(deviation, std::abs(field.data()[c] - reference[c]));
+        return deviation;
+    }
+
+    Settings settings;
+    std::shared_ptr<PartitionInformation> pi;
+    std::shared_ptr<Discretization> discretization;
+    std::shared_ptr<PartitionShell> partition;
+};
+
+//! bandwidth of a triad over arrays of the size of p, the reference for the memory bound kernels
+double measureTriadBandwidth(std::size_t length, int nRepetitions)
+{
+    std::vector<double> a(length, 0.0), b(length, 1.0), c(length, 2.0);
+    MPI_Barrier(MPI_COMM_WORLD);
+    const auto t0 = timestamp();
+    for(int r = 0; r < nRepetitions; r++)
+        for(std::size_t n = 0; n < length; n++)
+            a[n] = b[n] + 0.5 * c[n] + r;
+    double duration = getDurationS(t0);
+    MPI_Allreduce(MPI_IN_PLACE, &duration, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    // the result is used, so the loop is not removed
+    if(a[length/2] < 0.0)
+        std::cout << a[length/2];
+    return 3. * sizeof(double) * length * nRepetitions / duration;
+}
+
+//! SOR and red-black SOR against their wavefront variants. The modeled traffic assumes, that the neighbour planes
+//! of a sweep stay in cache, so a sweep of SOR streams p twice (load, store) and rhs once, Checkerboard does this
+//! for each colour and the wavefront kernels once per step. The effective bandwidth is the traffic of an untiled
+//! SOR sweep divided by the time per sweep, if it exceeds the triad bandwidth, the sweeps run from cache.
+void benchmark_wavefront(int nCells, int rank, int nRanks)
+{
+    BenchmarkSetup setup(nCells);
+    const double omega = 1.6;
+    const double epsilon = 1e-5;
+    const int nSweeps = 32;
+    const double cellsLocal = setup.pi->totalNoOfCellsLocal();
+    const double sorBytes = 3. * sizeof(double);
+
+    const double triad = measureTriadBandwidth(setup.discretization->p().length(), nSweeps);
+    std::stringstream out;
+    out << "Wavefront benchmark, " << nCells << "^3 cells on " << nRanks << " ranks, " << nSweeps << " sweeps\n"
+        << "triad bandwidth: " << std::setprecision(4) << triad * 1e-9 << " GB/s per rank\n"
+        << std::setw(30) << std::left << "kernel" << std::setw(18) << "ms per sweep"
+        << std::setw(24) << "modeled B/cell/sweep" << "effective GB/s\n";
+
+    auto report = [&](const std::string &name, double duration, double bytesPerCell)
+    {
+        const double perSweep = duration / nSweeps;
+        out << std::setw(30) << std::left << name << std::setw(18) << perSweep * 1e3
+            << std::setw(24) << bytesPerCell << sorBytes * cellsLocal / perSweep * 1e-9 << "\n";
+    };
+
+    setup.resetPressure();
+    SweepTimer<SOR> sor(setup.partition, epsilon, nSweeps, omega);
+    report("SOR", sor.timeSteps(nSweeps), sorBytes);
+
+    setup.resetPressure();
+    SweepTimer<Checkerboard> checkerboard(setup.partition, epsilon, nSweeps, omega);
+    report("Checkerboard", checkerboard.timeSteps(nSweeps), 2. * sorBytes);
+
+    for(int redBlack = 0; redBlack <= 1; redBlack++)
+    {
+        for(int sweeps : {1, 2, 4, 8})
+        {
+            setup.resetPressure();
+            SweepTimer<WavefrontSOR> wavefront(setup.partition, epsilon, nSweeps, omega, sweeps, redBlack);
+            std::stringstream name;
+            name << (redBlack ? "WavefrontCheckerboard" : "WavefrontSOR") << " (" << sweeps << ")";
+            report(name.str(), wavefront.timeSteps(nSweeps / sweeps), sorBytes / sweeps);
+        }
+    }
+    if(rank == 0)
+        std::cout << out.str() << std::endl;
+}
+
+//! the red-black row kernels the CPU supports, without the halo exchange between the colours, so only the kernel
+//! is timed. Each sweep relaxes both colours, a cell update counts once. The deviation to the scalar kernel after the
+//! first sweep verifies the SIMD kernels, they only differ in the rounding of the fused multiply-adds.
+void benchmark_redblack(int nCells, int rank, int nRanks)
+{
+    BenchmarkSetup setup(nCells);
+    Discretization &d = *setup.discretization;
+    const int nSweeps = 32;
+    const double dx2 = d.dx2(), dy2 = d.dy2(), dz2 = d.dz2();
+    const RedBlackCoefficients coefficients{1. / dx2, 1. / dy2, 1. / dz2,
+                                            (dx2 * dy2 * dz2) / (2. * (dy2*dz2+dx2*dz2+dx2*dy2)), 1.6};
+    const Array3DView p = d.pView(), b = d.rhsView();
+
+    auto sweep = [&](RedBlackRowKernel kernel)
+    {
+        double correction2 = 0.0;
+        for(int colour = 0; colour < 2; colour++)
+            for(int k = 0; k < d.pkN(); k++)
+                for(int j = 0; j < d.pjN(); j++)
+                    correction2 += kernel(p.row(0,j,k), b.row(0,j,k), p.strideY(), p.strideZ(),
+                                          ((k & 0b1) ^ (j & 0b1)) ^ colour, d.piN(), coefficients);
+        return correction2;
+    };
+
+    std::stringstream out;
+    out << "Red-black kernel benchmark, " << nCells << "^3 cells on " << nRanks << " ranks, " << nSweeps << " sweeps, "
+        << "selected: " << RedBlackKernel::selectedName() << "\n"
+        << std::setw(12) << std::left << "kernel" << std::setw(16) << "Mcells/s" << std::setw(10) << "speedup"
+        << "max deviation\n";
+
+    std::vector<double> reference;
+    double scalarRate = 0.0;
+    for(const auto &kernel : RedBlackKernel::available())
+    {
+        setup.resetPressure();
+        sweep(kernel.second);
+        double deviation = 0.0;
+        if(reference.empty())
+            reference.assign(d.p().data(), d.p().data() + d.p().length());
+        else
+            deviation = setup.deviationFrom(reference, d.p());
+        MPI_Allreduce(MPI_IN_PLACE, &deviation, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+        const double rate = setup.pi->totalNoOfCellsGlobal() / setup.timeRepetitions(nSweeps, [&]() { sweep(kernel.second); });
+        if(scalarRate == 0.0)
+            scalarRate = rate;
+        out << std::setw(12) << std::left << kernel.first << std::setw(16) << std::setprecision(4) << rate * 1e-6
+            << std::setw(10) << rate / scalarRate << deviation << "\n";
+    }
+    if(rank == 0)
+        std::cout << out.str() << std::endl;
+}
+
+//! the halos of p and of u, v and w packed into the buffers against the in place exchange with the MPI datatypes,
+//! separately for the x, y and z faces, which have strides of 1, the row and the plane. Both are timed with new
+//! requests for each message and with persistent requests, which a second partition on the same grid uses.
+//! The deviation compares the exchanged p of the packed and the in place variant, starting from a zero field,
+//! so the edges they exchange differently agree.
+void benchmark_halo(int nCells, int rank, int nRanks)
+{
+    BenchmarkSetup setup(nCells);
+    HaloTimer halo(setup.discretization, setup.settings, *setup.pi);
+    Settings persistentSettings = setup.settings;
+    persistentSettings.usePersistentComm = true;
+    HaloTimer persistentHalo(setup.discretization, persistentSettings, *setup.pi);
+    FieldVariable &p = setup.discretization->p();
+    const int nExchanges = 200;
+
+    std::stringstream out;
+    out << "Halo exchange benchmark, " << nCells << "^3 cells on " << nRanks << " ranks, " << nExchanges << " exchanges, "
+        << "us per exchange\n"
+        << std::setw(7) << std::left << "faces" << std::setw(7) << "field" << std::setw(10) << "packed"
+        << std::setw(12) << "persistent" << std::setw(10) << "in place" << std::setw(22) << "in place persistent"
+        << "max deviation\n";
+
+    const char *axisNames[3] = {"x", "y", "z"};
+    for(int axis = 0; axis < 3; axis++)
+    {
+        int nNeighbours = halo.nNeighbours(axis);
+        MPI_Allreduce(MPI_IN_PLACE, &nNeighbours, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+        if(nNeighbours == 0)
+        {
+            out << std::setw(7) << std::left << axisNames[axis] << "no neighbours\n";
+            continue;
+        }
+
+        std::vector<double> packed;
+        double deviation = 0.0;
+        for(bool inPlace : {false, true})
+        {
+            p.setToZero();
+            setup.resetPressure();
+            halo.timeExchanges(axis, inPlace, false, 1);
+            if(!inPlace)
+                packed.assign(p.data(), p.data() + p.length());
+            else
+                deviation = setup.deviationFrom(packed, p);
+        }
+        MPI_Allreduce(MPI_IN_PLACE, &deviation, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+        setup.resetVelocities();
+        for(bool velocities : {false, true})
+        {
+            out << std::setw(7) << std::left << axisNames[axis] << std::setw(7) << (velocities ? "u,v,w" : "p")
+                << std::setprecision(4);
+            for(bool inPlace : {false, true})
+            {
+                out << std::setw(10) << halo.timeExchanges(axis, inPlace, velocities, nExchanges) / nExchanges * 1e6
+                    << std::setw(inPlace ? 22 : 12)
+                    << persistentHalo.timeExchanges(axis, inPlace, velocities, nExchanges) / nExchanges * 1e6;
+            }
+            if(!velocities)
+                out << deviation;
+            out << "\n";
+        }
+    }
+    if(rank == 0)
+        std::cout << out.str() << std::endl;
+}
+
+//! F, G and H with the virtual stencils of the Discretization, as calculateFGH did before it was templated on the flux
+void calculateFGHVirtual(Discretization &d, const Settings &settings, double deltaT)
+{
+    for(int k = 0; k < d.ukN(); k++)
+        for(int j = 0; j < d.ujN(); j++)
+            for(int i = 0; i < d.uiN(); i++)
+                d.f(i,j,k) = d.u(i,j,k) + deltaT*((d.computeD2uDx2(i,j,k) + d.computeD2uDy2(i,j,k) + d.computeD2uDz2(i,j,k))/settings.re
+                             - d.computeDu2Dx(i,j,k) - d.computeDuvDy(i,j,k) - d.computeDuwDz(i,j,k) + settings.g[0]);
+    for(int k = 0; k < d.vkN(); k++)
+        for(int j = 0; j < d.vjN(); j++)
+            for(int i = 0; i < d.viN(); i++)
+                d.g(i,j,k) = d.v(i,j,k) + deltaT*((d.computeD2vDx2(i,j,k) + d.computeD2vDy2(i,j,k) + d.computeD2vDz2(i,j,k))/settings.re
+                             - d.computeDuvDx(i,j,k) - d.computeDv2Dy(i,j,k) - d.computeDvwDz(i,j,k) + settings.g[1]);
+    for(int k = 0; k < d.wkN(); k++)
+        for(int j = 0; j < d.wjN(); j++)
+            for(int i = 0; i < d.wiN(); i++)
+                d.h(i,j,k) = d.w(i,j,k) + deltaT*((d.computeD2wDx2(i,j,k) + d.computeD2wDy2(i,j,k) + d.computeD2wDz2(i,j,k))/settings.re
+                             - d.computeDuwDx(i,j,k) - d.computeDvwDy(i,j,k) - d.computeDw2Dz(i,j,k) + settings.g[2]);
+}
+
+//! the virtual stencils against the kernel templated on the flux, for both schemes. The F, G and H of a cell are
+//! counted as one cell update, the largest deviation between both variants is reported to verify the kernel.
+void benchmark_fgh(int nCells, int rank, int nRanks)
+{
+    const int nRepetitions = 10;
+    const double deltaT = 1e-3;
+    std::stringstream out;
+    out << "FGH benchmark, " << nCells << "^3 cells on " << nRanks << " ranks, " << nRepetitions << " repetitions\n"
+        << std::setw(22) << std::left << "scheme" << std::setw(18) << "virtual Mcells/s"
+        << std::setw(18) << "kernel Mcells/s" << std::setw(10) << "speedup" << "max deviation\n";
+
+    for(bool useDonorCell : {false, true})
+    {
+        BenchmarkSetup setup(nCells, useDonorCell);
+        setup.resetVelocities();
+        Discretization &d = *setup.discretization;
+
+        const double cellsGlobal = setup.pi->totalNoOfCellsGlobal();
+        const double virtualRate = cellsGlobal / setup.timeRepetitions(nRepetitions, [&]()
+        {
+            calculateFGHVirtual(d, setup.settings, deltaT);
+        });
+        std::vector<std::vector<double>> reference;
+        for(FieldVariable *field : {&d.f(), &d.g(), &d.h()})
+            reference.emplace_back(field->data(), field->data() + field->length());
+
+        const double kernelRate = cellsGlobal / setup.timeRepetitions(nRepetitions, [&]() { d.calculateFGH(deltaT); });
+        double deviation = 0.0;
+        int n = 0;
+        for(FieldVariable *field : {&d.f(), &d.g(), &d.h()})
+            deviation = std::max(deviation, setup.deviationFrom(reference[n++], *field));
+        MPI_Allreduce(MPI_IN_PLACE, &deviation, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+        out << std::setw(22) << std::left << (useDonorCell ? "DonorCell" : "CentralDifferences")
+            << std::setw(18) << std::setprecision(4) << virtualRate * 1e-6 << std::setw(18) << kernelRate * 1e-6
+            << std::setw(10) << kernelRate / virtualRate << deviation << "\n";
+    }
+    if(rank == 0)
+        std::cout << out.str() << std::endl;
+}
+
+//! the separate passes of a time step against the fused ones of useFusedKernels: calculateFGH, setBoundaryFGH and
+//! calculateRHS against calculateFGHAndRHS, setBoundaryFGH and calculateBoundaryRHS, and the velocity maxima of a full
+//! pass against the ones recorded by calculateUVW. The largest deviation of the rhs and of dt verify the fused path.
+void benchmark_fused(int nCells, int rank, int nRanks)
+{
+    const int nRepetitions = 10;
+    const double deltaT = 1e-3;
+    std::stringstream out;
+    out << "Fused kernels benchmark, " << nCells << "^3 cells on " << nRanks << " ranks, "
+        << nRepetitions << " repetitions\n" << std::setw(22) << std::left << "kernels"
+        << std::setw(16) << "separate ms" << std::setw(16) << "fused ms" << std::setw(10) << "speedup"
+        << "max deviation\n";
+
+    BenchmarkSetup setup(nCells);
+    setup.resetVelocities();
+    setup.resetPressure();
+    setup.partition->setBoundaryUVW();
+    Discretization &d = *setup.discretization;
+
+    auto report = [&](const std::string &name, double separate, double fused, double deviation)
+    {
+        MPI_Allreduce(MPI_IN_PLACE, &deviation, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+        out << std::setw(22) << std::left << name << std::setw(16) << std::setprecision(4) << separate * 1e3
+            << std::setw(16) << fused * 1e3 << std::setw(10) << separate / fused << deviation << "\n";
+    };
+
+    const double separateRHS = setup.timeRepetitions(nRepetitions, [&]()
+    {
+        d.calculateFGH(deltaT);
+        setup.partition->setBoundaryFGH();
+        d.calculateRHS(deltaT);
+    });
+    const std::vector<double> reference(d.rhs().data(), d.rhs().data() + d.rhs().length());
+    const double fusedRHS = setup.timeRepetitions(nRepetitions, [&]()
+    {
+        d.calculateFGHAndRHS(deltaT);
+        setup.partition->setBoundaryFGH();
+        d.calculateBoundaryRHS(deltaT);
+    });
+    report("FGH + RHS", separateRHS, fusedRHS, setup.deviationFrom(reference, d.rhs()));
+
+    // calculateUVW records the maxima, the boundary only sets the ghost layers like in the time loop
+    d.calculateUVW(deltaT);
+    setup.partition->setBoundaryUVW();
+    double separateDelta = 0.0, fusedDelta = 0.0;
+    setup.settings.useFusedKernels = false;
+    const double separate = setup.timeRepetitions(nRepetitions, [&]() { separateDelta = d.calculateVelocityDelta(); });
+    setup.settings.useFusedKernels = true;
+    const double fused = setup.timeRepetitions(nRepetitions, [&]() { fusedDelta = d.calculateVelocityDelta(); });
+    setup.settings.useFusedKernels = false;
+    report("velocity delta", separate, fused, std::abs(separateDelta - fusedDelta));
+
+    if(rank == 0)
+        std::cout << out.str() << std::endl;
+}
+
+//! the kernels of a time step with their halo exchange after them against the split of useOverlappedComm, which
+//! sends the shell and calculates the interior, while the faces are in flight: calculateFGH, setBoundaryFGH and
+//! calculateRHS, calculateUVW and exchangeUVW, and a Checkerboard step with its two exchanges of p.
+//! The largest deviation of the rhs, u and p verify, that the overlapped kernels calculate the same.
+void benchmark_overlap(int nCells, int rank, int nRanks)
+{
+    const int nRepetitions = 10;
+    const double deltaT = 1e-3;
+    std::stringstream out;
+    out << "Overlapped communication benchmark, " << nCells << "^3 cells on " << nRanks << " ranks, "
+        << nRepetitions << " repetitions\n" << std::setw(22) << std::left << "kernels"
+        << std::setw(16) << "blocking ms" << std::setw(16) << "overlapped ms" << std::setw(10) << "speedup"
+        << "max deviation\n";
+
+    BenchmarkSetup setup(nCells);
+    setup.resetVelocities();
+    setup.resetPressure();
+    setup.partition->setBoundaryUVW();
+    Discretization &d = *setup.discretization;
+    PartitionShell &partition = *setup.partition;
+
+    auto report = [&](const std::string &name, double blocking, double overlapped, double deviation)
+    {
+        MPI_Allreduce(MPI_IN_PLACE, &deviation, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+        out << std::setw(22) << std::left << name << std::setw(16) << std::setprecision(4) << blocking * 1e3
+            << std::setw(16) << overlapped * 1e3 << std::setw(10) << blocking / overlapped << deviation << "\n";
+    };
+
+    const double blockingRHS = setup.timeRepetitions(nRepetitions, [&]()
+    {
+        d.calculateFGH(deltaT);
+        partition.setBoundaryFGH();
+        d.calculateRHS(deltaT);
+    });
+    const std::vector<double> rhs(d.rhs().data(), d.rhs().data() + d.rhs().length());
+    const double overlappedRHS = setup.timeRepetitions(nRepetitions, [&]()
+    {
+        d.calculateFGH(deltaT, GridRegion::Shell);
+        partition.startBoundaryFGH();
+        d.calculateFGH(deltaT, GridRegion::Interior);
+        d.calculateRHS(deltaT, GridRegion::Interior);
+        partition.finishBoundaryFGH();
+        d.calculateRHS(deltaT, GridRegion::Shell);
+    });
+    report("FGH + RHS", blockingRHS, overlappedRHS, setup.deviationFrom(rhs, d.rhs()));
+
+    // u is recalculated from the same f, g and p in each repetition
+    const double blockingUVW = setup.timeRepetitions(nRepetitions, [&]()
+    {
+        d.calculateUVW(deltaT);
+        partition.exchangeUVW();
+    });
+    const std::vector<double> u(d.u().data(), d.u().data() + d.u().length());
+    const double overlappedUVW = setup.timeRepetitions(nRepetitions, [&]()
+    {
+        d.calculateUVW(deltaT, GridRegion::Shell);
+        partition.startExchangeUVW();
+        d.calculateUVW(deltaT, GridRegion::Interior);
+        partition.finishExchangeUVW();
+    });
+    report("UVW", blockingUVW, overlappedUVW, setup.deviationFrom(u, d.u()));
+
+    // both start from the same pressure, so they do the same steps, the halo of the last black cells is set afterwards
+    SweepTimer<Checkerboard> checkerboard(setup.partition, 1e-5, nRepetitions, 1.6);
+    setup.resetPressure();
+    const double blockingSteps = checkerboard.timeSteps(nRepetitions) / nRepetitions;
+    partition.setBoundaryP();
+    const std::vector<double> p(d.p().data(), d.p().data() + d.p().length());
+    setup.resetPressure();
+    checkerboard.setUseOverlappedComm(true);
+    const double overlappedSteps = checkerboard.timeSteps(nRepetitions) / nRepetitions;
+    partition.setBoundaryP();
+    report("Checkerboard step", blockingSteps, overlappedSteps, setup.deviationFrom(p, d.p()));
+
+    if(rank == 0)
+        std::cout << out.str() << std::endl;
+}
+
+//! The whole halo of p and of u, v and w exchanged with a message per neighbour and packed buffers, in place with
+//! the datatypes one direction after the other, and with one neighbourhood collective on the Cartesian communicator.
+//! The deviation compares the whole fields after the neighbourhood collective with the in place exchange starting
+//! from the same fields, both fill the edges and corners of the halo.
+void benchmark_neighbourhood(int nCells, int rank, int nRanks)
+{
+    BenchmarkSetup setup(nCells);
+    const PartitionInformation &pi = *setup.pi;
+    Settings inPlaceSettings = setup.settings;
+    inPlaceSettings.useDatatypeHalos = true;
+    Settings neighbourhoodSettings = setup.settings;
+    neighbourhoodSettings.useNeighbourCollectives = true;
+    const std::array<std::shared_ptr<PartitionShell>, 3> partitions{
+        setup.partition,
+        std::make_shared<AsyncPartition>(setup.discretization, inPlaceSettings, pi),
+        std::make_shared<AsyncPartition>(setup.discretization, neighbourhoodSettings, pi)};
+    Discretization &d = *setup.discretization;
+    const int nExchanges = 200;
+
+    std::stringstream out;
+    out << "Neighbourhood collective benchmark, " << nCells << "^3 cells on " << nRanks << " ranks, " << nExchanges
+        << " exchanges of the whole halo, us per exchange\n" << std::setw(7) << std::left << "field"
+        << std::setw(10) << "packed" << std::setw(10) << "in place" << std::setw(15) << "neighbourhood"
+        << "max deviation\n";
+
+    for(bool velocities : {false, true})
+    {
+        const std::array<FieldVariable *, 3> fields{velocities ? &d.u() : &d.p(), &d.v(), &d.w()};
+        std::array<std::vector<double>, 3> inPlace;
+        double deviation = 0.0;
+        for(int variant : {1, 2})
+        {
+            // the velocities are reset including their ghost layers, the pressure without
+            d.p().setToZero();
+            setup.resetPressure();
+            setup.resetVelocities();
+            if(velocities)
+                partitions[variant]->exchangeUVW();
+            else
+                partitions[variant]->exchangeP();
+            // the whole fields including the edges and corners of the halo, which the output interpolates p from
+            for(int f = 0; f < (velocities ? 3 : 1); f++)
+            {
+                if(variant == 1)
+                    inPlace[f].assign(fields[f]->data(), fields[f]->data() + fields[f]->length());
+                else
+                    deviation = std::max(deviation, setup.deviationFrom(inPlace[f], *fields[f]));
+            }
+        }
+        MPI_Allreduce(MPI_IN_PLACE, &deviation, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+        out << std::setw(7) << std::left << (velocities ? "u,v,w" : "p") << std::setprecision(4);
+        for(int variant = 0; variant < 3; variant++)
+        {
+            PartitionShell &partition = *partitions[variant];
+            const double duration = setup.timeRepetitions(nExchanges, [&]()
+            {
+                if(velocities)
+                    partition.exchangeUVW();
+                else
+                    partition.exchangeP();
+            });
+            out << std::setw(variant == 2 ? 15 : 10) << duration * 1e6;
+        }
+        out << deviation << "\n";
+    }
+    if(rank == 0)
+        std::cout << out.str() << std::endl;
+}
+
+//! the threaded kernels of a time step with 1, 2, 4, ... threads up to OMP_NUM_THREADS, the speedup is relative to
+//! 1 thread. Each rank runs its own threads, so with several ranks per node the threads of all ranks share the cores.
+void benchmark_threads(int nCells, int rank, int nRanks)
+{
+    const int nRepetitions = 10;
+    const double deltaT = 1e-3;
+    BenchmarkSetup setup(nCells);
+    setup.resetVelocities();
+    setup.resetPressure();
+    Discretization &d = *setup.discretization;
+    SweepTimer<Checkerboard> checkerboard(setup.partition, 1e-5, nRepetitions, 1.6);
+
+    int maxThreads = 1;
+    #ifdef _OPENMP
+    maxThreads = omp_get_max_threads();
+    #endif
+    std::vector<int> nThreads;
+    for(int t = 1; t < maxThreads; t *= 2)
+        nThreads.push_back(t);
+    nThreads.push_back(maxThreads);
+
+    // the kernels do not depend on each other's results here, they only have to do the same work for each thread count
+    double sink = 0.0;
+    std::vector<std::pair<std::string, std::function<void()>>> kernels{
+        {"calculateFGH",           [&]() { d.calculateFGH(deltaT); }},
+        {"calculateRHS",           [&]() { d.calculateRHS(deltaT); }},
+        {"calculateUVW",           [&]() { d.calculateUVW(deltaT); }},
+        {"calculateVelocityDelta", [&]() { sink += d.calculateVelocityDelta(); }},
+        {"residuum",               [&]() { sink += checkerboard.partitionResiduum2(); }},
+        {"Checkerboard step",      [&]() { checkerboard.timeSteps(1); }}
+    };
+
+    std::stringstream out;
+    out << "Thread scaling benchmark, " << nCells << "^3 cells on " << nRanks << " ranks, "
+        << nRepetitions << " repetitions, ms per call (speedup)\n" << std::setw(24) << std::left << "kernel";
+    for(int t : nThreads)
+        out << std::setw(18) << (std::to_string(t) + " threads");
+    out << "\n";
+
+    for(auto &kernel : kernels)
+    {
+        out << std::setw(24) << std::left << kernel.first;
+        double serial = 0.0;
+        for(int t : nThreads)
+        {
+            #ifdef _OPENMP
+            omp_set_num_threads(t);
+            #endif
+            // one untimed call, so the threads are started and the pages are touched
+            kernel.second();
+            const double duration = setup.timeRepetitions(nRepetitions, kernel.second);
+            if(t == 1)
+                serial = duration;
+            std::stringstream cell;
+            cell << std::setprecision(4) << duration * 1e3 << " (" << std::setprecision(3) << serial / duration << ")";
+            out << std::setw(18) << cell.str();
+        }
+        out << "\n";
+    }
+    #ifdef _OPENMP
+    omp_set_num_threads(maxThreads);
+    #endif
+    if(rank == 0)
+        std::cout << out.str() << (sink < 0.0 ? " " : "") << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    // only the main thread communicates, the threads of the kernels never call MPI
+    int threadSupport;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &threadSupport);
+
+    int world_size;
+    MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+    int world_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+
+    const std::string benchmark = argc > 1 ? argv[1] : "wavefront";
+    const int nCells = argc > 2 ? std::stoi(argv[2]) : 128;
+
+    if(benchmark == "wavefront")
+        benchmark_wavefront(nCells, world_rank, world_size);
+    else if(benchmark == "fgh")
+        benchmark_fgh(nCells, world_rank, world_size);
+    else if(benchmark == "threads")
+        benchmark_threads(nCells, world_rank, world_size);
+    else if(benchmark == "fused")
+        benchmark_fused(nCells, world_rank, world_size);
+    else if(benchmark == "redblack")
+        benchmark_redblack(nCells, world_rank, world_size);
+    else if(benchmark == "halo")
+        benchmark_halo(nCells, world_rank, world_size);
+    else if(benchmark == "overlap")
+        benchmark_overlap(nCells, world_rank, world_size);
+    else if(benchmark == "neighbourhood")
+        benchmark_neighbourhood(nCells, world_rank, world_size);
+    else if(world_rank == 0)
+        std::cerr << "Unknown benchmark \"" << benchmark << "\", available are: wavefront, fgh, threads, fused, redblack, halo, "
+                  << "overlap, neighbourhood\n";
+
+    MPI_Finalize();
+    return EXIT_SUCCESS;
+}
@@ -1,31 +1,193 @@
 #include "boundary/async_neighbour_boundary.h"
 
-void AsyncNeighbourTop::exchangeP()
+void AsyncNeighbourBoundary::exchangeDeepPlanes(Array3D &field, int axis, int sendFirst, int depth)
+{
+    const std::array<int, 3> size = field.size();
+    const int axis0 = (axis == 0) ? 1 : 0;
+    const int axis1 = (axis == 2) ? 1 : 2;
+    const std::size_t len = (std::size_t)depth * size[axis0] * size[axis1];
+    deepSendBuf_.resize(len);
+    deepRecvBuf_.resize(len);
+    mpiHandler_.startReceive(deepRecvBuf_.data(), len);
+
+    // the planes are ordered along the axis on both sides, so the i-th sent plane is the i-th received one
+    std::size_t n = 0;
+    std::array<int, 3> index;
+    for(index[axis1] = 0; index[axis1] < size[axis1]; index[axis1]++)
+        for(index[axis0] = 0; index[axis0] < size[axis0]; index[axis0]++)
+            for(index[axis] = sendFirst; index[axis] < sendFirst + depth; index[axis]++)
+                deepSendBuf_[n++] = field(index[0], index[1], index[2]);
+    mpiHandler_.send(deepSendBuf_.data(), len);
+}
+
+void AsyncNeighbourBoundary::setRecvDeepPlanes(Array3D &field, int axis, int recvFirst, int depth)
+{
+    const std::array<int, 3> size = field.size();
+    const int axis0 = (axis == 0) ? 1 : 0;
+    const int axis1 = (axis == 2) ? 1 : 2;
+    std::size_t n = 0;
+    std::array<int, 3> index;
+    for(index[axis1] = 0; index[axis1] < size[axis1]; index[axis1]++)
+        for(index[axis0] = 0; index[axis0] < size[axis0]; index[axis0]++)
+            for(index[axis] = recvFirst; index[axis] < recvFirst + depth; index[axis]++)
+                field(index[0], index[1], index[2]) = deepRecvBuf_[n++];
+}
+
+AsyncNeighbourBoundary::~AsyncNeighbourBoundary()
+{
+    // the partitions may outlive MPI_Finalize, the types are freed with it anyway
+    int finalized;
+    MPI_Finalized(&finalized);
+    if(finalized)
+        return;
+    for(MPI_Datatype *type : {&cellSendType_, &cellRecvType_, &uvwSendType_, &uvwRecvType_, &fghSendType_, &fghRecvType_})
+    {
+        if(*type != MPI_DATATYPE_NULL)
+            MPI_Type_free(type);
+    }
+}
+
+int AsyncNeighbourBoundary::axis() const
+{
+    switch(edge_)
+    {
+    case BoundaryEdge::LEFT:
+    case BoundaryEdge::RIGHT:
+        return 0;
+    case BoundaryEdge::BOTTOM:
+    case BoundaryEdge::TOP:
+        return 1;
+    default:
+        return 2;
+    }
+}
+
+MPI_Datatype AsyncNeighbourBoundary::createFaceType(const std::array<int, 3> &size, bool recv) const
+{
+    const int a = axis();
+    const bool upper = edge_ == BoundaryEdge::RIGHT || edge_ == BoundaryEdge::TOP || edge_ == BoundaryEdge::FRONT;
+    std::array<int, 3> subsize = size;
+    std::array<int, 3> start{0, 0, 0};
+    subsize[a] = 1;
+    start[a] = upper ? size[a] - (recv ? 1 : 2) : (recv ? 0 : 1);
+
+    // i is the fastest index, which is the column major order of MPI
+    MPI_Datatype type;
+    MPI_Type_create_subarray(3, size.data(), subsize.data(), start.data(), MPI_ORDER_FORTRAN, MPI_DOUBLE, &type);
+    return type;
+}
+
+MPI_Datatype AsyncNeighbourBoundary::createFacesType(FieldVariable &x, FieldVariable &y, FieldVariable &z, bool recv) const
+{
+    std::array<MPI_Datatype, 3> faces{createFaceType(x.size(), recv), createFaceType(y.size(), recv),
+                                      createFaceType(z.size(), recv)};
+    std::array<MPI_Aint, 3> addresses;
+    MPI_Get_address(x.data(), &addresses[0]);
+    MPI_Get_address(y.data(), &addresses[1]);
+    MPI_Get_address(z.data(), &addresses[2]);
+    const std::array<int, 3> blockLengths{1, 1, 1};
+
+    MPI_Datatype type;
+    MPI_Type_create_struct(3, blockLengths.data(), addresses.data(), faces.data(), &type);
+    MPI_Type_commit(&type);
+    for(MPI_Datatype &face : faces)
+        MPI_Type_free(&face);
+    return type;
+}
+
+void AsyncNeighbourBoundary::createFaceTypes()
+{
+    if(hasFaceTypes())
+        return;
+    cellSendType_ = createFaceType(p_.size(), false);
+    cellRecvType_ = createFaceType(p_.size(), true);
+    MPI_Type_commit(&cellSendType_);
+    MPI_Type_commit(&cellRecvType_);
+    uvwSendType_ = createFacesType(u_, v_, w_, false);
+    uvwRecvType_ = createFacesType(u_, v_, w_, true);
+    fghSendType_ = createFacesType(f_, g_, h_, false);
+    fghRecvType_ = createFacesType(f_, g_, h_, true);
+}
+
+void AsyncNeighbourBoundary::exchangeCellFieldInPlace(FieldVariable &field)
+{
+    assert(field.size() == p_.size());
+    mpiHandler_.startReceive(field.data(), cellRecvType_);
+    mpiHandler_.send(field.data(), cellSendType_);
+}
+
+void AsyncNeighbourBoundary::exchangeUVWInPlace()
+{
+    mpiHandler_.startReceive(MPI_BOTTOM, uvwRecvType_);
+    mpiHandler_.send(MPI_BOTTOM, uvwSendType_);
+}
+
+void AsyncNeighbourBoundary::exchangeFGHInPlace()
+{
+    mpiHandler_.startReceive(MPI_BOTTOM, fghRecvType_);
+    mpiHandler_.send(MPI_BOTTOM, fghSendType_);
+}
+
+template<typename Field, typename Buffer>
+void AsyncNeighbourTop::packCellField(Field &field, Buffer &sendBuf)
 {
-    mpiHandler_.startReceive(pRecvBuf_.data(), pRecvBuf_.length());
     #pragma omp simd collapse(2)
     for(int k = hindOffset_; k < pkLen_ - frontOffset_; k++)
     {
         for(int i = leftOffset_; i < piLen_ - rightOffset_; i++)
         {
-            pSendBuf_(i,k) = p_(i,pjLen_-2,k);
+            sendBuf(i,k) = field(i,pjLen_-2,k);
         }
     }
+}
+
+void AsyncNeighbourTop::exchangeCellField(FieldVariable &field)
+{
+    mpiHandler_.startReceive(pRecvBuf_.data(), pRecvBuf_.length());
+    packCellField(field, pSendBuf_);
     mpiHandler_.send(pSendBuf_.data(), pSendBuf_.length());
 }
 
-void AsyncNeighbourTop::setRecvP()
+void AsyncNeighbourTop::exchangeCellField(FloatArray3D &field)
+{
+    mpiHandler_.startReceive(pFloatRecvBuf_.data(), pFloatRecvBuf_.length());
+    packCellField(field, pFloatSendBuf_);
+    mpiHandler_.send(pFloatSendBuf_.data(), pFloatSendBuf_.length());
+}
+
+template<typename Field, typename Buffer>
+void AsyncNeighbourTop::unpackCellField(Field &field, Buffer &recvBuf)
 {
     #pragma omp simd collapse(2)
     for(int k = hindOffset_; k < pkLen_ - frontOffset_; k++)
     {
         for(int i = leftOffset_; i < piLen_ - rightOffset_; i++)
         {
-            p_(i,pjLen_-1,k) = pRecvBuf_(i,k);
+            field(i,pjLen_-1,k) = recvBuf(i,k);
         }
     }
 }
 
+void AsyncNeighbourTop::setRecvCellField(FieldVariable &field)
+{
+    unpackCellField(field, pRecvBuf_);
+}
+
+void AsyncNeighbourTop::setRecvCellField(FloatArray3D &field)
+{
+    unpackCellField(field, pFloatRecvBuf_);
+}
+
+void AsyncNeighbourTop::exchangeDeepCellField(Array3D &field, int depth)
+{
+    exchangeDeepPlanes(field, 1, field.size()[1] - 2*depth, depth);
+}
+
+void AsyncNeighbourTop::setRecvDeepCellField(Array3D &field, int depth)
+{
+    setRecvDeepPlanes(field, 1, field.size()[1] - depth, depth);
+}
+
 void AsyncNeighbourTop::exchangeUVW()
 {
     mpiHandler_.startReceive(velRecvBuf_.data(), velRecvBuf_.length());
@@ -142,32 +304,66 @@ void AsyncNeighbourTop::setRecvFGH()
     }
 }
 
-void AsyncNeighbourRight::exchangeP()
+template<typename Field, typename Buffer>
+void AsyncNeighbourRight::packCellField(Field &field, Buffer &sendBuf)
 {
-    mpiHandler_.startReceive(pRecvBuf_.data(), pRecvBuf_.length());
     #pragma omp simd collapse(2)
     for(int k = 0; k < pkLen_; k++)
     {
         for(int j = 0; j < pjLen_; j++)
         {
-            pSendBuf_(j,k) = p_(piLen_-2,j,k);
+            sendBuf(j,k) = field(piLen_-2,j,k);
         }
     }
+}
+
+void AsyncNeighbourRight::exchangeCellField(FieldVariable &field)
+{
+    mpiHandler_.startReceive(pRecvBuf_.data(), pRecvBuf_.length());
+    packCellField(field, pSendBuf_);
     mpiHandler_.send(pSendBuf_.data(), pSendBuf_.length());
 }
 
-void AsyncNeighbourRight::setRecvP()
+void AsyncNeighbourRight::exchangeCellField(FloatArray3D &field)
+{
+    mpiHandler_.startReceive(pFloatRecvBuf_.data(), pFloatRecvBuf_.length());
+    packCellField(field, pFloatSendBuf_);
+    mpiHandler_.send(pFloatSendBuf_.data(), pFloatSendBuf_.length());
+}
+
+template<typename Field, typename Buffer>
+void AsyncNeighbourRight::unpackCellField(Field &field, Buffer &recvBuf)
 {
     #pragma omp simd collapse(2)
     for(int k = 0; k < pkLen_; k++)
     {
         for(int j = 0; j < pjLen_; j++)
         {
-            p_(piLen_-1,j,k) = pRecvBuf_(j,k);
+            field(piLen_-1,j,k) = recvBuf(j,k);
         }
     }
 }
 
+void AsyncNeighbourRight::setRecvCellField(FieldVariable &field)
+{
+    unpackCellField(field, pRecvBuf_);
+}
+
+void AsyncNeighbourRight::setRecvCellField(FloatArray3D &field)
+{
+    unpackCellField(field, pFloatRecvBuf_);
+}
+
+void AsyncNeighbourRight::exchangeDeepCellField(Array3D &field, int depth)
+{
+    exchangeDeepPlanes(field, 0, field.size()[0] - 2*depth, depth);
+}
+
+void AsyncNeighbourRight::setRecvDeepCellField(Array3D &field, int depth)
+{
+    setRecvDeepPlanes(field, 0, field.size()[0] - depth, depth);
+}
+
 void AsyncNeighbourRight::exchangeUVW()
 {
     mpiHandler_.startReceive(velRecvBuf_.data(), velRecvBuf_.length());
@@ -284,32 +480,66 @@ void AsyncNeighbourRight::setRecvFGH()
     }
 }
 
-void AsyncNeighbourBottom::exchangeP()
+template<typename Field, typename Buffer>
+void AsyncNeighbourBottom::packCellField(Field &field, Buffer &sendBuf)
 {
-    mpiHandler_.startReceive(pRecvBuf_.data(), pRecvBuf_.length());
     #pragma omp simd collapse(2)
     for(int k = hindOffset_; k < pkLen_ - frontOffset_; k++)
     {
         for(int i = leftOffset_; i < piLen_ - rightOffset_; i++)
         {
-            pSendBuf_(i,k) = p_(i,1,k);
+            sendBuf(i,k) = field(i,1,k);
         }
     }
+}
+
+void AsyncNeighbourBottom::exchangeCellField(FieldVariable &field)
+{
+    mpiHandler_.startReceive(pRecvBuf_.data(), pRecvBuf_.length());
+    packCellField(field, pSendBuf_);
     mpiHandler_.send(pSendBuf_.data(), pSendBuf_.length());
 }
 
-void AsyncNeighbourBottom::setRecvP()
+void AsyncNeighbourBottom::exchangeCellField(FloatArray3D &field)
+{
+    mpiHandler_.startReceive(pFloatRecvBuf_.data(), pFloatRecvBuf_.length());
+    packCellField(field, pFloatSendBuf_);
+    mpiHandler_.send(pFloatSendBuf_.data(), pFloatSendBuf_.length());
+}
+
+template<typename Field, typename Buffer>
+void AsyncNeighbourBottom::unpackCellField(Field &field, Buffer &recvBuf)
 {
     #pragma omp simd collapse(2)
     for(int k = hindOffset_; k < pkLen_ - frontOffset_; k++)
     {
         for(int i = leftOffset_; i < piLen_ - rightOffset_; i++)
         {
-            p_(i,0,k) = pRecvBuf_(i,k);
+            field(i,0,k) = recvBuf(i,k);
         }
     }
 }
 
+void AsyncNeighbourBottom::setRecvCellField(FieldVariable &field)
+{
+    unpackCellField(field, pRecvBuf_);
+}
+
+void AsyncNeighbourBottom::setRecvCellField(FloatArray3D &field)
+{
+    unpackCellField(field, pFloatRecvBuf_);
+}
+
+void AsyncNeighbourBottom::exchangeDeepCellField(Array3D &field, int depth)
+{
+    exchangeDeepPlanes(field, 1, depth, depth);
+}
+
+void AsyncNeighbourBottom::setRecvDeepCellField(Array3D &field, int depth)
+{
+    setRecvDeepPlanes(field, 1, 0, depth);
+}
+
 void AsyncNeighbourBottom::exchangeUVW()
 {
     mpiHandler_.startReceive(velRecvBuf_.data(), velRecvBuf_.length());
@@ -426,32 +656,66 @@ void AsyncNeighbourBottom::setRecvFGH()
     }
 }
 
-void AsyncNeighbourLeft::exchangeP()
+template<typename Field, typename Buffer>
+void AsyncNeighbourLeft::packCellField(Field &field, Buffer &sendBuf)
 {
-    mpiHandler_.startReceive(pRecvBuf_.data(), pRecvBuf_.length());
     #pragma omp simd collapse(2)
     for(int k = 0; k < pkLen_; k++)
     {
         for(int j = 0; j < pjLen_; j++)
         {
-            pSendBuf_(j,k) = p_(1,j,k);
+            sendBuf(j,k) = field(1,j,k);
         }
     }
+}
+
+void AsyncNeighbourLeft::exchangeCellField(FieldVariable &field)
+{
+    mpiHandler_.startReceive(pRecvBuf_.data(), pRecvBuf_.length());
+    packCellField(field, pSendBuf_);
     mpiHandler_.send(pSendBuf_.data(), pSendBuf_.length());
 }
 
-void AsyncNeighbourLeft::setRecvP()
+void AsyncNeighbourLeft::exchangeCellField(FloatArray3D &field)
+{
+    mpiHandler_.startReceive(pFloatRecvBuf_.data(), pFloatRecvBuf_.length());
+    packCellField(field, pFloatSendBuf_);
+    mpiHandler_.send(pFloatSendBuf_.data(), pFloatSendBuf_.length());
+}
+
+template<typename Field, typename Buffer>
+void AsyncNeighbourLeft::unpackCellField(Field &field, Buffer &recvBuf)
 {
     #pragma omp simd collapse(2)
     for(int k = 0; k < pkLen_; k++)
     {
         for(int j = 0; j < pjLen_; j++)
         {
-            p_(0,j,k) = pRecvBuf_(j,k);
+            field(0,j,k) = recvBuf(j,k);
         }
     }
 }
 
+void AsyncNeighbourLeft::setRecvCellField(FieldVariable &field)
+{
+    unpackCellField(field, pRecvBuf_);
+}
+
+void AsyncNeighbourLeft::setRecvCellField(FloatArray3D &field)
+{
+    unpackCellField(field, pFloatRecvBuf_);
+}
+
+void AsyncNeighbourLeft::exchangeDeepCellField(Array3D &field, int depth)
+{
+    exchangeDeepPlanes(field, 0, depth, depth);
+}
+
+void AsyncNeighbourLeft::setRecvDeepCellField(Array3D &field, int depth)
+{
+    setRecvDeepPlanes(field, 0, 0, depth);
+}
+
 void AsyncNeighbourLeft::exchangeUVW()
 {
     mpiHandler_.startReceive(velRecvBuf_.data(), velRecvBuf_.length());
@@ -568,32 +832,66 @@ void AsyncNeighbourLeft::setRecvFGH()
     }
 }
 
-void AsyncNeighbourHind::exchangeP()
+template<typename Field, typename Buffer>
+void AsyncNeighbourHind::packCellField(Field &field, Buffer &sendBuf)
 {
-    mpiHandler_.startReceive(pRecvBuf_.data(), pRecvBuf_.length());
     #pragma omp simd collapse(2)
     for(int j = 0; j < pjLen_; j++)
     {
         for(int i = leftOffset_; i < piLen_ - rightOffset_; i++)
         {
-            pSendBuf_(i,j) = p_(i,j,1);
+            sendBuf(i,j) = field(i,j,1);
         }
     }
+}
+
+void AsyncNeighbourHind::exchangeCellField(FieldVariable &field)
+{
+    mpiHandler_.startReceive(pRecvBuf_.data(), pRecvBuf_.length());
+    packCellField(field, pSendBuf_);
     mpiHandler_.send(pSendBuf_.data(), pSendBuf_.length());
 }
 
-void AsyncNeighbourHind::setRecvP()
+void AsyncNeighbourHind::exchangeCellField(FloatArray3D &field)
+{
+    mpiHandler_.startReceive(pFloatRecvBuf_.data(), pFloatRecvBuf_.length());
+    packCellField(field, pFloatSendBuf_);
+    mpiHandler_.send(pFloatSendBuf_.data(), pFloatSendBuf_.length());
+}
+
+template<typename Field, typename Buffer>
+void AsyncNeighbourHind::unpackCellField(Field &field, Buffer &recvBuf)
 {
     #pragma omp simd collapse(2)
     for(int j = 0; j < pjLen_; j++)
     {
         for(int i = leftOffset_; i < piLen_ - rightOffset_; i++)
         {
-            p_(i,j,0) = pRecvBuf_(i,j);
+            field(i,j,0) = recvBuf(i,j);
         }
     }
 }
 
+void AsyncNeighbourHind::setRecvCellField(FieldVariable &field)
+{
+    unpackCellField(field, pRecvBuf_);
+}
+
+void AsyncNeighbourHind::setRecvCellField(FloatArray3D &field)
+{
+    unpackCellField(field, pFloatRecvBuf_);
+}
+
+void AsyncNeighbourHind::exchangeDeepCellField(Array3D &field, int depth)
+{
+    exchangeDeepPlanes(field, 2, depth, depth);
+}
+
+void AsyncNeighbourHind::setRecvDeepCellField(Array3D &field, int depth)
+{
+    setRecvDeepPlanes(field, 2, 0, depth);
+}
+
 void AsyncNeighbourHind::exchangeUVW()
 {
     mpiHandler_.startReceive(velRecvBuf_.data(), velRecvBuf_.length());
@@ -710,32 +1008,66 @@ void AsyncNeighbourHind::setRecvFGH()
     }
 }
 
-void AsyncNeighbourFront::exchangeP()
+template<typename Field, typename Buffer>
+void AsyncNeighbourFront::packCellField(Field &field, Buffer &sendBuf)
 {
-    mpiHandler_.startReceive(pRecvBuf_.data(), pRecvBuf_.length());
     #pragma omp simd collapse(2)
     for(int j = 0; j < pjLen_; j++)
     {
         for(int i = leftOffset_; i < piLen_ - rightOffset_; i++)
         {
-            pSendBuf_(i,j) = p_(i,j,pkLen_-2);
+            sendBuf(i,j) = field(i,j,pkLen_-2);
         }
     }
+}
+
+void AsyncNeighbourFront::exchangeCellField(FieldVariable &field)
+{
+    mpiHandler_.startReceive(pRecvBuf_.data(), pRecvBuf_.length());
+    packCellField(field, pSendBuf_);
     mpiHandler_.send(pSendBuf_.data(), pSendBuf_.length());
 }
 
-void AsyncNeighbourFront::setRecvP()
+void AsyncNeighbourFront::exchangeCellField(FloatArray3D &field)
+{
+    mpiHandler_.startReceive(pFloatRecvBuf_.data(), pFloatRecvBuf_.length());
+    packCellField(field, pFloatSendBuf_);
+    mpiHandler_.send(pFloatSendBuf_.data(), pFloatSendBuf_.length());
+}
+
+template<typename Field, typename Buffer>
+void AsyncNeighbourFront::unpackCellField(Field &field, Buffer &recvBuf)
 {
     #pragma omp simd collapse(2)
     for(int j = 0; j < pjLen_; j++)
     {
         for(int i = leftOffset_; i < piLen_ - rightOffset_; i++)
         {
-            p_(i,j,pkLen_-1) = pRecvBuf_(i,j);
+            field(i,j,pkLen_-1) = recvBuf(i,j);
         }
     }
 }
 
+void AsyncNeighbourFront::setRecvCellField(FieldVariable &field)
+{
+    unpackCellField(field, pRecvBuf_);
+}
+
+void AsyncNeighbourFront::setRecvCellField(FloatArray3D &field)
+{
+    unpackCellField(field, pFloatRecvBuf_);
+}
+
+void AsyncNeighbourFront::exchangeDeepCellField(Array3D &field, int depth)
+{
+    exchangeDeepPlanes(field, 2, field.size()[2] - 2*depth, depth);
+}
+
+void AsyncNeighbourFront::setRecvDeepCellField(Array3D &field, int depth)
+{
+    setRecvDeepPlanes(field, 2, field.size()[2] - depth, depth);
+}
+
 void AsyncNeighbourFront::exchangeUVW()
 {
     mpiHandler_.startReceive(velRecvBuf_.data(), velRecvBuf_.length());
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <vector>
 #include <sstream>
 #include <iostream>
 #include <mpi.h>
@@ -10,6 +11,8 @@
 #include "storage/field_variable.h"
 #include "storage/array3D.h"
 #include "storage/array2D.h"
+#include "storage/float_array2D.h"
+#include "storage/float_array3D.h"
 
 enum ind : int
 {
@@ -24,23 +27,55 @@ class AsyncNeighbourBoundary : public Boundary
 public:
     //! Requires edge and length information, child classes may set them implicitely
     AsyncNeighbourBoundary(std::shared_ptr<Discretization> d, 
-                      BoundaryEdge edge, int neighbourRank, std::array<int, 2> velBufLen, std::array<int, 2> pBufLen) : 
+                      BoundaryEdge edge, int neighbourRank, MPI_Comm comm,
+                      std::array<int, 2> velBufLen, std::array<int, 2> pBufLen) : 
                       Boundary(d, edge), neighbourRank_(neighbourRank),
                       pBufLen_(pBufLen), velBufLen_(velBufLen),
-                      mpiHandler_(neighbourRank),
+                      mpiHandler_(neighbourRank, comm),
                       // 3 for ind::X, ind::Y, ind::Z for velocity
                       velSendBuf_({velBufLen[0], velBufLen[1], 3}), velRecvBuf_({velBufLen[0], velBufLen[1], 3}),
-                      pSendBuf_(pBufLen), pRecvBuf_(pBufLen) { }
+                      pSendBuf_(pBufLen), pRecvBuf_(pBufLen),
+                      pFloatSendBuf_(pBufLen, "pFloatSendBuf"), pFloatRecvBuf_(pBufLen, "pFloatRecvBuf") { }
+
+    //! frees the face datatypes, if they were created
+    virtual ~AsyncNeighbourBoundary();
     
     //! sends UV data and setups receive for it
     virtual void exchangeUVW() = 0;
     virtual void exchangeFGH() = 0;
-    virtual void exchangeP()   = 0;
+    inline  void exchangeP() { exchangeCellField(p_); }
+    //! sends any field with the same layout as p, e.g. the work vectors of the Krylov solvers
+    virtual void exchangeCellField(FieldVariable &field) = 0;
+    //! same with single precision halos, used by the mixed precision pressure solver
+    virtual void exchangeCellField(FloatArray3D &field) = 0;
 
     //! sets the boundary to the values received in the buffer
     virtual void setRecvUVW() = 0;
     virtual void setRecvFGH() = 0;
-    virtual void setRecvP()   = 0;
+    inline  void setRecvP() { setRecvCellField(p_); }
+    virtual void setRecvCellField(FieldVariable &field) = 0;
+    virtual void setRecvCellField(FloatArray3D &field) = 0;
+
+    //! exchanges depth layers of a cell field with depth ghost layers, the other two directions are sent completely,
+    //! including their ghost layers, so exchanging one direction after the other also fills the edges and corners
+    virtual void exchangeDeepCellField(Array3D &field, int depth) = 0;
+    virtual void setRecvDeepCellField(Array3D &field, int depth) = 0;
+
+    //! Builds the MPI datatypes of the faces once, afterwards the InPlace exchanges send the faces directly from the
+    //! fields and receive them directly into the ghost layers, without the pack and unpack passes of the buffers.
+    //! Unlike the buffers, the faces span the whole plane including the ghost layers of the other directions,
+    //! so a received ghost layer is sent on by the next direction and the directions have to be exchanged one after
+    //! the other (like the deep halos), which also fills the edges of the halo.
+    void createFaceTypes();
+    inline bool hasFaceTypes() const { return cellSendType_ != MPI_DATATYPE_NULL; }
+    //! direction normal to the boundary, 0 (left, right), 1 (bottom, top) or 2 (hind, front)
+    int axis() const;
+
+    //! the field has to have the size of p, it may not be changed until waitForSendComplete
+    void exchangeCellFieldInPlace(FieldVariable &field);
+    //! u, v and w or f, g and h are sent in one message, which is described by the absolute addresses of the faces
+    void exchangeUVWInPlace();
+    void exchangeFGHInPlace();
 
     //! Communication handler
     MPI_Wrapper mpiHandler_;
@@ -58,7 +93,30 @@ protected:
     Array3D velRecvBuf_;
     Array2D pSendBuf_;
     Array2D pRecvBuf_;
+    //! the single precision cell fields are sent with half the message size
+    FloatArray2D pFloatSendBuf_;
+    FloatArray2D pFloatRecvBuf_;
+    //! datatypes of the sent face and received ghost layer, the cell types are relative to the start of the field
+    MPI_Datatype cellSendType_ = MPI_DATATYPE_NULL;
+    MPI_Datatype cellRecvType_ = MPI_DATATYPE_NULL;
+    MPI_Datatype uvwSendType_ = MPI_DATATYPE_NULL;
+    MPI_Datatype uvwRecvType_ = MPI_DATATYPE_NULL;
+    MPI_Datatype fghSendType_ = MPI_DATATYPE_NULL;
+    MPI_Datatype fghRecvType_ = MPI_DATATYPE_NULL;
+    //! the deep halo buffers depend on the depth, they are resized on demand
+    std::vector<double> deepSendBuf_;
+    std::vector<double> deepRecvBuf_;
     //! it may be a good idea, to wrap the mpi comm into a seperate class
+
+    //! starts the receive and sends the planes [sendFirst, sendFirst+depth) along axis
+    void exchangeDeepPlanes(Array3D &field, int axis, int sendFirst, int depth);
+    //! copies the received planes into [recvFirst, recvFirst+depth) along axis
+    void setRecvDeepPlanes(Array3D &field, int axis, int recvFirst, int depth);
+
+    //! uncommitted subarray of the plane next to the boundary (recv = false) or of the ghost layer (recv = true)
+    MPI_Datatype createFaceType(const std::array<int, 3> &size, bool recv) const;
+    //! committed struct of the faces of three fields at their absolute addresses
+    MPI_Datatype createFacesType(FieldVariable &x, FieldVariable &y, FieldVariable &z, bool recv) const;
 };
 
 //! given the two indices, this function returns the maximum size of the velocity field
@@ -84,8 +142,8 @@ public:
     //! Both velocity directions are sent simultaniously, so add them up for the buffer. 
     //! It is north, so they are sliced in x-direction.
     //! north and south neighbours have the quirk, that they may not override the edge values of their partitions' east/west neighbours
-    AsyncNeighbourTop(std::shared_ptr<Discretization> d, int neighbourRank, bool leftNeighbour, bool rightNeighbour, bool hindNeighbour, bool frontNeighbour) :
-                   AsyncNeighbourBoundary(d, BoundaryEdge::TOP, neighbourRank,
+    AsyncNeighbourTop(std::shared_ptr<Discretization> d, int neighbourRank, MPI_Comm comm, bool leftNeighbour, bool rightNeighbour, bool hindNeighbour, bool frontNeighbour) :
+                   AsyncNeighbourBoundary(d, BoundaryEdge::TOP, neighbourRank, comm,
                    getVelSize(d, ind::X, ind::Z), getPSize(d, ind::X, ind::Z)),
                    leftOffset_(leftNeighbour ? 1 : 0), rightOffset_(rightNeighbour ? 1 : 0),
                    frontOffset_(frontNeighbour ? 1 : 0), hindOffset_(hindNeighbour ? 1 : 0)
@@ -100,13 +158,21 @@ public:
 
     void exchangeUVW() override;
     void exchangeFGH() override;
-    void exchangeP()  override;
+    void exchangeCellField(FieldVariable &field) override;
+    void exchangeCellField(FloatArray3D &field) override;
 
     void setRecvUVW() override;
     void setRecvFGH() override;
-    void setRecvP()  override;
+    void setRecvCellField(FieldVariable &field) override;
+    void setRecvCellField(FloatArray3D &field) override;
+    void exchangeDeepCellField(Array3D &field, int depth) override;
+    void setRecvDeepCellField(Array3D &field, int depth) override;
 
 private:
+    //! shared by the double and single precision cell fields
+    template<typename Field, typename Buffer> void packCellField(Field &field, Buffer &sendBuf);
+    template<typename Field, typename Buffer> void unpackCellField(Field &field, Buffer &recvBuf);
+
     const int leftOffset_;
     const int rightOffset_;
     const int frontOffset_;
@@ -116,8 +182,8 @@ private:
 class AsyncNeighbourRight : public AsyncNeighbourBoundary
 {
 public:
-    AsyncNeighbourRight(std::shared_ptr<Discretization> d, int neighbourRank) :
-                   AsyncNeighbourBoundary(d, BoundaryEdge::RIGHT, neighbourRank,
+    AsyncNeighbourRight(std::shared_ptr<Discretization> d, int neighbourRank, MPI_Comm comm) :
+                   AsyncNeighbourBoundary(d, BoundaryEdge::RIGHT, neighbourRank, comm,
                    getVelSize(d, ind::Y, ind::Z), getPSize(d, ind::Y, ind::Z)) 
                     {
                         velSendBuf_.rename("right.velSendBuf");
@@ -128,18 +194,27 @@ public:
 
     void exchangeUVW() override;
     void exchangeFGH() override;
-    void exchangeP()  override;
+    void exchangeCellField(FieldVariable &field) override;
+    void exchangeCellField(FloatArray3D &field) override;
 
     void setRecvUVW() override;
     void setRecvFGH() override;
-    void setRecvP()  override;
+    void setRecvCellField(FieldVariable &field) override;
+    void setRecvCellField(FloatArray3D &field) override;
+    void exchangeDeepCellField(Array3D &field, int depth) override;
+    void setRecvDeepCellField(Array3D &field, int depth) override;
+
+private:
+    //! shared by the double and single precision cell fields
+    template<typename Field, typename Buffer> void packCellField(Field &field, Buffer &sendBuf);
+    template<typename Field, typename Buffer> void unpackCellField(Field &field, Buffer &recvBuf);
 };
 
 class AsyncNeighbourBottom : public AsyncNeighbourBoundary
 {
 public:
-    AsyncNeighbourBottom(std::shared_ptr<Discretization> d, int neighbourRank, bool leftNeighbour, bool rightNeighbour, bool hindNeighbour, bool frontNeighbour) :
-                   AsyncNeighbourBoundary(d, BoundaryEdge::BOTTOM, neighbourRank,
+    AsyncNeighbourBottom(std::shared_ptr<Discretization> d, int neighbourRank, MPI_Comm comm, bool leftNeighbour, bool rightNeighbour, bool hindNeighbour, bool frontNeighbour) :
+                   AsyncNeighbourBoundary(d, BoundaryEdge::BOTTOM, neighbourRank, comm,
                    getVelSize(d, ind::X, ind::Z), getPSize(d, ind::X, ind::Z)),
                    leftOffset_(leftNeighbour ? 1 : 0), rightOffset_(rightNeighbour ? 1 : 0),
                    hindOffset_(hindNeighbour ? 1 : 0), frontOffset_(frontNeighbour ? 1 : 0)
@@ -152,13 +227,21 @@ public:
 
     void exchangeUVW() override;
     void exchangeFGH() override;
-    void exchangeP()  override;
+    void exchangeCellField(FieldVariable &field) override;
+    void exchangeCellField(FloatArray3D &field) override;
 
     void setRecvUVW() override;
     void setRecvFGH() override;
-    void setRecvP()  override;
+    void setRecvCellField(FieldVariable &field) override;
+    void setRecvCellField(FloatArray3D &field) override;
+    void exchangeDeepCellField(Array3D &field, int depth) override;
+    void setRecvDeepCellField(Array3D &field, int depth) override;
 
 private:
+    //! shared by the double and single precision cell fields
+    template<typename Field, typename Buffer> void packCellField(Field &field, Buffer &sendBuf);
+    template<typename Field, typename Buffer> void unpackCellField(Field &field, Buffer &recvBuf);
+
     const int leftOffset_;
     const int rightOffset_;
     const int hindOffset_;
@@ -168,8 +251,8 @@ private:
 class AsyncNeighbourLeft : public AsyncNeighbourBoundary
 {
 public:
-    AsyncNeighbourLeft(std::shared_ptr<Discretization> d, int neighbourRank) :
-                   AsyncNeighbourBoundary(d, BoundaryEdge::LEFT, neighbourRank,
+    AsyncNeighbourLeft(std::shared_ptr<Discretization> d, int neighbourRank, MPI_Comm comm) :
+                   AsyncNeighbourBoundary(d, BoundaryEdge::LEFT, neighbourRank, comm,
                    getVelSize(d, ind::Y, ind::Z), getPSize(d, ind::Y, ind::Z))
                     {
                         velSendBuf_.rename("left.velSendBuf");
@@ -180,18 +263,27 @@ public:
                    
     void exchangeUVW() override;
     void exchangeFGH() override;
-    void exchangeP()  override;
+    void exchangeCellField(FieldVariable &field) override;
+    void exchangeCellField(FloatArray3D &field) override;
 
     void setRecvUVW() override;
     void setRecvFGH() override;
-    void setRecvP()  override;
+    void setRecvCellField(FieldVariable &field) override;
+    void setRecvCellField(FloatArray3D &field) override;
+    void exchangeDeepCellField(Array3D &field, int depth) override;
+    void setRecvDeepCellField(Array3D &field, int depth) override;
+
+private:
+    //! shared by the double and single precision cell fields
+    template<typename Field, typename Buffer> void packCellField(Field &field, Buffer &sendBuf);
+    template<typename Field, typename Buffer> void unpackCellField(Field &field, Buffer &recvBuf);
 };
 
 class AsyncNeighbourHind : public AsyncNeighbourBoundary
 {
 public:
-    AsyncNeighbourHind(std::shared_ptr<Discretization> d, int neighbourRank, bool leftNeighbour, bool rightNeighbour) :
-                   AsyncNeighbourBoundary(d, BoundaryEdge::HIND, neighbourRank,
+    AsyncNeighbourHind(std::shared_ptr<Discretization> d, int neighbourRank, MPI_Comm comm, bool leftNeighbour, bool rightNeighbour) :
+                   AsyncNeighbourBoundary(d, BoundaryEdge::HIND, neighbourRank, comm,
                    getVelSize(d, ind::X, ind::Y), getPSize(d, ind::X, ind::Y)),
                    leftOffset_(leftNeighbour ? 1 : 0), rightOffset_(rightNeighbour ? 1 : 0) 
                     {
@@ -203,13 +295,21 @@ public:
                    
     void exchangeUVW() override;
     void exchangeFGH() override;
-    void exchangeP()  override;
+    void exchangeCellField(FieldVariable &field) override;
+    void exchangeCellField(FloatArray3D &field) override;
 
     void setRecvUVW() override;
     void setRecvFGH() override;
-    void setRecvP()  override;
+    void setRecvCellField(FieldVariable &field) override;
+    void setRecvCellField(FloatArray3D &field) override;
+    void exchangeDeepCellField(Array3D &field, int depth) override;
+    void setRecvDeepCellField(Array3D &field, int depth) override;
 
 private:
+    //! shared by the double and single precision cell fields
+    template<typename Field, typename Buffer> void packCellField(Field &field, Buffer &sendBuf);
+    template<typename Field, typename Buffer> void unpackCellField(Field &field, Buffer &recvBuf);
+
     int leftOffset_;
     int rightOffset_;
 };
@@ -217,8 +317,8 @@ private:
 class AsyncNeighbourFront : public AsyncNeighbourBoundary
 {
 public:
-    AsyncNeighbourFront(std::shared_ptr<Discretization> d, int neighbourRank, bool leftNeighbour, bool rightNeighbour) :
-                   AsyncNeighbourBoundary(d, BoundaryEdge::FRONT, neighbourRank,
+    AsyncNeighbourFront(std::shared_ptr<Discretization> d, int neighbourRank, MPI_Comm comm, bool leftNeighbour, bool rightNeighbour) :
+                   AsyncNeighbourBoundary(d, BoundaryEdge::FRONT, neighbourRank, comm,
                    getVelSize(d, ind::X, ind::Y), getPSize(d, ind::X, ind::Y)),
                    leftOffset_(leftNeighbour ? 1 : 0), rightOffset_(rightNeighbour ? 1 : 0)
                     {
@@ -230,13 +330,21 @@ public:
                    
     void exchangeUVW() override;
     void exchangeFGH() override;
-    void exchangeP()  override;
+    void exchangeCellField(FieldVariable &field) override;
+    void exchangeCellField(FloatArray3D &field) override;
 
     void setRecvUVW() override;
     void setRecvFGH() override;
-    void setRecvP()  override;
+    void setRecvCellField(FieldVariable &field) override;
+    void setRecvCellField(FloatArray3D &field) override;
+    void exchangeDeepCellField(Array3D &field, int depth) override;
+    void setRecvDeepCellField(Array3D &field, int depth) override;
 
 private:
+    //! shared by the double and single precision cell fields
+    template<typename Field, typename Buffer> void packCellField(Field &field, Buffer &sendBuf);
+    template<typename Field, typename Buffer> void unpackCellField(Field &field, Buffer &recvBuf);
+
     int leftOffset_;
     int rightOffset_;
 };
\ No newline at end of file
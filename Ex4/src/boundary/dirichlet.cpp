@@ -1,5 +1,24 @@
 #include "boundary/dirichlet.h"
 
+void Dirichlet::copyPlane(Array3D &field, int axis, int from, int to)
+{
+    const std::array<int, 3> size = field.size();
+    const int axis0 = (axis == 0) ? 1 : 0;
+    const int axis1 = (axis == 2) ? 1 : 2;
+    std::array<int, 3> fromIndex, toIndex;
+    fromIndex[axis] = from;
+    toIndex[axis] = to;
+    for(int b = 0; b < size[axis1]; b++)
+    {
+        for(int a = 0; a < size[axis0]; a++)
+        {
+            fromIndex[axis0] = toIndex[axis0] = a;
+            fromIndex[axis1] = toIndex[axis1] = b;
+            field(toIndex[0], toIndex[1], toIndex[2]) = field(fromIndex[0], fromIndex[1], fromIndex[2]);
+        }
+    }
+}
+
 void DirichletTop::setUVW()
 {
     #pragma omp simd collapse(2)
@@ -58,18 +77,34 @@ void DirichletTop::setFGH()
     }
 }
 
-void DirichletTop::setP()
+template<typename Field>
+void DirichletTop::setHomogeneousNeumann(Field &field)
 {
     #pragma omp simd collapse(2)
     for(int k = 1; k < pkLen_-1; k++)
     {
         for(int i = 1; i < piLen_-1; i++) 
         {
-            p_(i,pjLen_-1,k) = p_(i,pjLen_-2,k);
+            field(i,pjLen_-1,k) = field(i,pjLen_-2,k);
         }
     }
 }
 
+void DirichletTop::setCellField(FieldVariable &field)
+{
+    setHomogeneousNeumann(field);
+}
+
+void DirichletTop::setCellField(FloatArray3D &field)
+{
+    setHomogeneousNeumann(field);
+}
+
+void DirichletTop::setDeepCellField(Array3D &field, int depth)
+{
+    copyPlane(field, 1, field.size()[1] - depth - 1, field.size()[1] - depth);
+}
+
 void DirichletRight::setUVW()
 {
     #pragma omp simd collapse(2)
@@ -126,18 +161,34 @@ void DirichletRight::setFGH()
     }
 }
 
-void DirichletRight::setP()
+template<typename Field>
+void DirichletRight::setHomogeneousNeumann(Field &field)
 {
     #pragma omp simd collapse(2)
     for(int k = 0; k < pkLen_; k++)
     {
         for(int j = 0; j < pjLen_; j++) 
         {
-            p_(piLen_-1,j,k) = p_(piLen_-2,j,k);
+            field(piLen_-1,j,k) = field(piLen_-2,j,k);
         }
     }
 }
 
+void DirichletRight::setCellField(FieldVariable &field)
+{
+    setHomogeneousNeumann(field);
+}
+
+void DirichletRight::setCellField(FloatArray3D &field)
+{
+    setHomogeneousNeumann(field);
+}
+
+void DirichletRight::setDeepCellField(Array3D &field, int depth)
+{
+    copyPlane(field, 0, field.size()[0] - depth - 1, field.size()[0] - depth);
+}
+
 void DirichletBottom::setUVW()
 {
     #pragma omp simd collapse(2)
@@ -194,18 +245,34 @@ void DirichletBottom::setFGH()
     }
 }
 
-void DirichletBottom::setP()
+template<typename Field>
+void DirichletBottom::setHomogeneousNeumann(Field &field)
 {
     #pragma omp simd collapse(2)
     for(int k = 1; k < pkLen_-1; k++)
     {
         for(int i = 1; i < piLen_-1; i++) 
         {
-            p_(i,0,k) = p_(i,1,k);
+            field(i,0,k) = field(i,1,k);
         }
     }
 }
 
+void DirichletBottom::setCellField(FieldVariable &field)
+{
+    setHomogeneousNeumann(field);
+}
+
+void DirichletBottom::setCellField(FloatArray3D &field)
+{
+    setHomogeneousNeumann(field);
+}
+
+void DirichletBottom::setDeepCellField(Array3D &field, int depth)
+{
+    copyPlane(field, 1, depth, depth - 1);
+}
+
 void DirichletLeft::setUVW()
 {
     #pragma omp simd collapse(2)
@@ -262,18 +329,34 @@ void DirichletLeft::setFGH()
     }
 }
 
-void DirichletLeft::setP()
+template<typename Field>
+void DirichletLeft::setHomogeneousNeumann(Field &field)
 {
     #pragma omp simd collapse(2)
     for(int k = 0; k < pkLen_; k++)
     {
         for(int j = 0; j < pjLen_; j++) 
         {
-            p_(0,j,k) = p_(1,j,k);
+            field(0,j,k) = field(1,j,k);
         }
     }
 }
 
+void DirichletLeft::setCellField(FieldVariable &field)
+{
+    setHomogeneousNeumann(field);
+}
+
+void DirichletLeft::setCellField(FloatArray3D &field)
+{
+    setHomogeneousNeumann(field);
+}
+
+void DirichletLeft::setDeepCellField(Array3D &field, int depth)
+{
+    copyPlane(field, 0, depth, depth - 1);
+}
+
 void DirichletFront::setUVW()
 {
     #pragma omp simd collapse(2)
@@ -331,18 +414,34 @@ void DirichletFront::setFGH()
     }
 }
 
-void DirichletFront::setP()
+template<typename Field>
+void DirichletFront::setHomogeneousNeumann(Field &field)
 {
     #pragma omp simd collapse(2)
     for(int j = 0; j < pjLen_; j++)
     {
         for(int i = 0; i < piLen_; i++)
         {
-            p_(i,j,pkLen_-1) = p_(i,j,pkLen_-2);
+            field(i,j,pkLen_-1) = field(i,j,pkLen_-2);
         }
     }
 }
 
+void DirichletFront::setCellField(FieldVariable &field)
+{
+    setHomogeneousNeumann(field);
+}
+
+void DirichletFront::setCellField(FloatArray3D &field)
+{
+    setHomogeneousNeumann(field);
+}
+
+void DirichletFront::setDeepCellField(Array3D &field, int depth)
+{
+    copyPlane(field, 2, field.size()[2] - depth - 1, field.size()[2] - depth);
+}
+
 void DirichletHind::setUVW()
 {
     #pragma omp simd collapse(2)
@@ -399,14 +498,30 @@ void DirichletHind::setFGH()
     }
 }
 
-void DirichletHind::setP()
+template<typename Field>
+void DirichletHind::setHomogeneousNeumann(Field &field)
 {
     #pragma omp simd collapse(2)
     for(int j = 0; j < pjLen_; j++)
     {
         for(int i = 0; i < piLen_; i++)
         {
-            p_(i,j,0) = p_(i,j,1);
+            field(i,j,0) = field(i,j,1);
         }
     }
+}
+
+void DirichletHind::setCellField(FieldVariable &field)
+{
+    setHomogeneousNeumann(field);
+}
+
+void DirichletHind::setCellField(FloatArray3D &field)
+{
+    setHomogeneousNeumann(field);
+}
+
+void DirichletHind::setDeepCellField(Array3D &field, int depth)
+{
+    copyPlane(field, 2, depth, depth - 1);
 }
\ No newline at end of file
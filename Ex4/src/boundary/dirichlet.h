@@ -4,6 +4,8 @@
 #include <mpi.h>
 #include "discretization/discretization.h"
 #include "boundary/boundary.h"
+#include "storage/array3D.h"
+#include "storage/float_array3D.h"
 
 class Dirichlet : public Boundary
 {
@@ -17,9 +19,23 @@ public:
 
     virtual void setFGH() = 0;
 
-    virtual void setP() = 0;
+    //! sets the homogeneous Neumann condition of the pressure
+    inline void setP() { setCellField(p_); }
+
+    //! sets the homogeneous Neumann condition on any field with the same layout as p,
+    //! e.g. the work vectors of the Krylov solvers
+    virtual void setCellField(FieldVariable &field) = 0;
+    //! same for the single precision fields of the mixed precision pressure solver
+    virtual void setCellField(FloatArray3D &field) = 0;
+
+    //! sets the homogeneous Neumann condition on the innermost ghost layer of a field with depth ghost layers,
+    //! the ghost layers of the other directions are included, the outer ghost layers are not used by the stencil
+    virtual void setDeepCellField(Array3D &field, int depth) = 0;
 
 protected:
+    //! copies the plane from to the plane to along axis, including all ghost layers of the other directions
+    void copyPlane(Array3D &field, int axis, int from, int to);
+
     //! direction of flow
     const double velX_;
     const double velY_;
@@ -35,7 +51,12 @@ public:
 
     void setUVW() override;
     void setFGH() override;
-    void setP() override;
+    void setCellField(FieldVariable &field) override;
+    void setCellField(FloatArray3D &field) override;
+    void setDeepCellField(Array3D &field, int depth) override;
+
+private:
+    template<typename Field> void setHomogeneousNeumann(Field &field);
 };
 
 class DirichletRight : public Dirichlet
@@ -46,7 +67,12 @@ public:
 
     void setUVW() override;
     void setFGH() override;
-    void setP() override;
+    void setCellField(FieldVariable &field) override;
+    void setCellField(FloatArray3D &field) override;
+    void setDeepCellField(Array3D &field, int depth) override;
+
+private:
+    template<typename Field> void setHomogeneousNeumann(Field &field);
 };
 
 class DirichletBottom : public Dirichlet
@@ -57,7 +83,12 @@ public:
 
     void setUVW() override;
     void setFGH() override;
-    void setP() override;
+    void setCellField(FieldVariable &field) override;
+    void setCellField(FloatArray3D &field) override;
+    void setDeepCellField(Array3D &field, int depth) override;
+
+private:
+    template<typename Field> void setHomogeneousNeumann(Field &field);
 };
 
 class DirichletLeft : public Dirichlet
@@ -68,7 +99,12 @@ public:
                    
     void setUVW() override;
     void setFGH() override;
-    void setP() override;
+    void setCellField(FieldVariable &field) override;
+    void setCellField(FloatArray3D &field) override;
+    void setDeepCellField(Array3D &field, int depth) override;
+
+private:
+    template<typename Field> void setHomogeneousNeumann(Field &field);
 };
 
 class DirichletFront : public Dirichlet
@@ -79,7 +115,12 @@ public:
                    
     void setUVW() override;
     void setFGH() override;
-    void setP() override;
+    void setCellField(FieldVariable &field) override;
+    void setCellField(FloatArray3D &field) override;
+    void setDeepCellField(Array3D &field, int depth) override;
+
+private:
+    template<typename Field> void setHomogeneousNeumann(Field &field);
 };
 
 class DirichletHind : public Dirichlet
@@ -90,5 +131,10 @@ public:
                    
     void setUVW() override;
     void setFGH() override;
-    void setP() override;
+    void setCellField(FieldVariable &field) override;
+    void setCellField(FloatArray3D &field) override;
+    void setDeepCellField(Array3D &field, int depth) override;
+
+private:
+    template<typename Field> void setHomogeneousNeumann(Field &field);
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <array>
 #include <cassert>
 #include <mpi.h>
 
@@ -10,47 +11,157 @@
 class MPI_Wrapper
 {
 public:
-    MPI_Wrapper(int neighbourRank) : neighbourRank_(neighbourRank) { }
+    //! the rank of the neighbour is the one in comm, the communicator of the partitions
+    MPI_Wrapper(int neighbourRank, MPI_Comm comm) : neighbourRank_(neighbourRank), comm_(comm) { }
+
+    //! completes the last send and frees the persistent requests
+    ~MPI_Wrapper()
+    {
+        // the partitions may outlive MPI_Finalize, the requests are freed with it anyway
+        int finalized;
+        MPI_Finalized(&finalized);
+        if(finalized)
+            return;
+        waitForSendComplete();
+        for(Channel &channel : channels_)
+        {
+            MPI_Request_free(&channel.requests[0]);
+            MPI_Request_free(&channel.requests[1]);
+        }
+    }
+
+    //! Each exchange with a new combination of buffers, lengths and datatypes creates persistent requests for it
+    //! (MPI_Recv_init, MPI_Send_init) from now on, which the following exchanges with the same combination restart
+    //! with MPI_Startall. The halos are always exchanged with the same few buffers, so only the first exchange of
+    //! each pays the setup of the requests. The receive is started together with the send, after the packing.
+    inline void usePersistentRequests() { persistent_ = true; }
 
     //! setups the receive request, it requires a valid receive buffer
     inline void startReceive(double *recvBuf, int len)
     {
-        MPI_Irecv(recvBuf, len, MPI_DOUBLE, neighbourRank_, 0, MPI_COMM_WORLD, &recvRequest_);
-        expectedRecvLen_ = len;
+        postReceive(recvBuf, len, MPI_DOUBLE);
+    }
+
+    //! same for single precision halos of the mixed precision solver
+    inline void startReceive(float *recvBuf, int len)
+    {
+        postReceive(recvBuf, len, MPI_FLOAT);
     }
 
-    //! wrapper for sending
+    //! receives one element of a derived datatype, which describes the halo in place, e.g. the ghost layer of a field
+    inline void startReceive(void *recvBuf, MPI_Datatype type)
+    {
+        postReceive(recvBuf, 1, type);
+    }
+
+    //! wrapper for sending, the send buffer may only be reused after waitForSendComplete
     inline void send(double *sendBuf, int len)
     {
-        MPI_Request sendReq;    // request handle is ignored
-        MPI_Isend(sendBuf, len, MPI_DOUBLE, neighbourRank_, 0, MPI_COMM_WORLD, &sendReq);
+        postSend(sendBuf, len, MPI_DOUBLE);
+    }
+
+    inline void send(float *sendBuf, int len)
+    {
+        postSend(sendBuf, len, MPI_FLOAT);
+    }
+
+    //! sends one element of a derived datatype, the described memory may not be changed until waitForSendComplete
+    inline void send(const void *sendBuf, MPI_Datatype type)
+    {
+        postSend(sendBuf, 1, type);
     }
 
-    //! checks, if the asynchronoues receive is complete 
-    //! w/o destroying the request handle
-    inline bool queryRecvComplete()
+    //! blocking wait for the last send to finish, it returns immediately, if there is none.
+    //! Large messages are not buffered by MPI, so it reads the send buffer until the neighbour received it.
+    inline void waitForSendComplete()
     {
-        // std::cout << "queryRecvComplete handler " << this << std::endl;
-        MPI_Status recvStatus;
-        int requestStatusComplete;
-        MPI_Request_get_status(recvRequest_, &requestStatusComplete, &recvStatus);
-        int count;
-        MPI_Get_count(&recvStatus, MPI_DOUBLE, &count);
-        return requestStatusComplete && count == expectedRecvLen_;
+        MPI_Wait(activeSend(), MPI_STATUS_IGNORE);
     }
 
     //! blocking wait for the receive to finish, destroys the handle
     inline void waitForRecvComplete()
     {
-        MPI_Wait(&recvRequest_, MPI_STATUS_IGNORE);
+        MPI_Wait(activeRecv(), MPI_STATUS_IGNORE);
     }
 
+    //! handle of the last receive, so several of them can be completed together with MPI_Waitsome,
+    //! the handle returned by it has to be written back
+    inline MPI_Request &recvRequest() { return *activeRecv(); }
+
 protected:
+    //! persistent receive and send of one combination of buffers
+    struct Channel
+    {
+        void *recvBuf;
+        int recvLen;
+        MPI_Datatype recvType;
+        const void *sendBuf;
+        int sendLen;
+        MPI_Datatype sendType;
+        std::array<MPI_Request, 2> requests;
+    };
+
+    inline void postReceive(void *recvBuf, int len, MPI_Datatype type)
+    {
+        expectedRecvLen_ = len;
+        recvType_ = type;
+        if(persistent_)
+        {
+            // started with the send, which determines the channel
+            pendingRecvBuf_ = recvBuf;
+            return;
+        }
+        MPI_Irecv(recvBuf, len, type, neighbourRank_, 0, comm_, &recvRequest_);
+        activeChannel_ = -1;
+    }
+
+    inline void postSend(const void *sendBuf, int len, MPI_Datatype type)
+    {
+        if(!persistent_)
+        {
+            MPI_Isend(sendBuf, len, type, neighbourRank_, 0, comm_, &sendRequest_);
+            activeChannel_ = -1;
+            return;
+        }
+        activeChannel_ = findChannel(sendBuf, len, type);
+        MPI_Startall(2, channels_[activeChannel_].requests.data());
+    }
+
+    //! index of the channel of the pending receive and this send, which is created, if it does not exist yet
+    inline int findChannel(const void *sendBuf, int sendLen, MPI_Datatype sendType)
+    {
+        for(int c = 0; c < (int)channels_.size(); c++)
+        {
+            const Channel &channel = channels_[c];
+            if(channel.recvBuf == pendingRecvBuf_ && channel.recvLen == expectedRecvLen_ && channel.recvType == recvType_
+               && channel.sendBuf == sendBuf && channel.sendLen == sendLen && channel.sendType == sendType)
+                return c;
+        }
+        Channel channel{pendingRecvBuf_, expectedRecvLen_, recvType_, sendBuf, sendLen, sendType, {}};
+        MPI_Recv_init(pendingRecvBuf_, expectedRecvLen_, recvType_, neighbourRank_, 0, comm_, &channel.requests[0]);
+        MPI_Send_init(sendBuf, sendLen, sendType, neighbourRank_, 0, comm_, &channel.requests[1]);
+        channels_.push_back(channel);
+        return (int)channels_.size() - 1;
+    }
+
+    //! requests of the last exchange
+    inline MPI_Request *activeRecv() { return activeChannel_ < 0 ? &recvRequest_ : &channels_[activeChannel_].requests[0]; }
+    inline MPI_Request *activeSend() { return activeChannel_ < 0 ? &sendRequest_ : &channels_[activeChannel_].requests[1]; }
+
     //! Rank to communicate with
     const int neighbourRank_;
+    const MPI_Comm comm_;
 
     //! used to check, if a transaction is complete
-    MPI_Request recvRequest_;
-    //! length of last transaction
+    MPI_Request recvRequest_ = MPI_REQUEST_NULL;
+    MPI_Request sendRequest_ = MPI_REQUEST_NULL;
+    //! length and datatype of last transaction
     int expectedRecvLen_;
-};
\ No newline at end of file
+    MPI_Datatype recvType_ = MPI_DOUBLE;
+
+    bool persistent_ = false;
+    std::vector<Channel> channels_;
+    //! channel of the last exchange, -1 for the non-persistent requests above
+    int activeChannel_ = -1;
+    void *pendingRecvBuf_ = nullptr;
+};
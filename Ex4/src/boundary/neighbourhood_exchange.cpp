@@ -0,0 +1,184 @@
+#include "boundary/neighbourhood_exchange.h"
+
+NeighbourhoodExchange::NeighbourhoodExchange(std::shared_ptr<Discretization> discretization,
+                                             const PartitionInformation &pi) :
+                                             discretization_(discretization),
+                                             neighbours_({{!pi.ownLeftBoundary(), !pi.ownBottomBoundary(), !pi.ownHindBoundary()},
+                                                          {!pi.ownRightBoundary(), !pi.ownTopBoundary(), !pi.ownFrontBoundary()}})
+{
+    int topology;
+    MPI_Topo_test(pi.comm(), &topology);
+    if(topology != MPI_CART)
+    {
+        std::stringstream str;
+        str << "R:" << pi.ownRankNo() << " the neighbourhood exchange requires the Cartesian communicator of the partitions\n";
+        throw std::runtime_error(str.str());
+    }
+
+    // the dimensions of the Cartesian communicator are {z, y, x}
+    std::array<int, 3> dims, periods, coords;
+    MPI_Cart_get(pi.comm(), 3, dims.data(), periods.data(), coords.data());
+    std::vector<int> ranks;
+    std::array<int, 3> offset;
+    for(offset[2] = -1; offset[2] <= 1; offset[2]++)
+    {
+        for(offset[1] = -1; offset[1] <= 1; offset[1]++)
+        {
+            for(offset[0] = -1; offset[0] <= 1; offset[0]++)
+            {
+                // the faces, edges and corners, the output interpolates p from the corners of the halo
+                if(offset == std::array<int, 3>{0, 0, 0})
+                    continue;
+                std::array<int, 3> position;
+                bool inside = true;
+                for(int d = 0; d < 3; d++)
+                {
+                    position[2-d] = coords[2-d] + offset[d];
+                    inside = inside && position[2-d] >= 0 && position[2-d] < dims[2-d];
+                }
+                if(!inside)
+                    continue;
+                int rank;
+                MPI_Cart_rank(pi.comm(), position.data(), &rank);
+                ranks.push_back(rank);
+                offsets_.push_back(offset);
+            }
+        }
+    }
+    // the neighbourhood is symmetric, the ranks are kept, as the partitions are already placed
+    MPI_Dist_graph_create_adjacent(pi.comm(), ranks.size(), ranks.data(), MPI_UNWEIGHTED,
+                                   ranks.size(), ranks.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, 0, &comm_);
+    displacements_.assign(offsets_.size(), 0);
+
+    cellFaces_ = createCellFaces(false);
+    pFaces_ = createCellFaces(true);
+    uvwFaces_ = createFaces(discretization->u(), discretization->v(), discretization->w());
+    fghFaces_ = createFaces(discretization->f(), discretization->g(), discretization->h());
+}
+
+NeighbourhoodExchange::~NeighbourhoodExchange()
+{
+    // the partitions may outlive MPI_Finalize, the types and the communicator are freed with it anyway
+    int finalized;
+    MPI_Finalized(&finalized);
+    if(finalized)
+        return;
+    finish();
+    freeFaces(cellFaces_);
+    freeFaces(pFaces_);
+    freeFaces(uvwFaces_);
+    freeFaces(fghFaces_);
+    MPI_Comm_free(&comm_);
+}
+
+MPI_Datatype NeighbourhoodExchange::createFaceType(const std::array<int, 3> &size, const std::array<int, 3> &offset,
+                                                   bool recv) const
+{
+    std::array<int, 3> subsize;
+    std::array<int, 3> start;
+    for(int d = 0; d < 3; d++)
+    {
+        if(offset[d] == 0)
+        {
+            start[d] = neighbours_.lower[d];
+            subsize[d] = size[d] - neighbours_.lower[d] - neighbours_.upper[d];
+        }
+        else
+        {
+            start[d] = offset[d] > 0 ? size[d] - (recv ? 1 : 2) : (recv ? 0 : 1);
+            subsize[d] = 1;
+        }
+    }
+
+    // i is the fastest index, which is the column major order of MPI
+    MPI_Datatype type;
+    MPI_Type_create_subarray(3, size.data(), subsize.data(), start.data(), MPI_ORDER_FORTRAN, MPI_DOUBLE, &type);
+    return type;
+}
+
+NeighbourhoodExchange::Faces NeighbourhoodExchange::createCellFaces(bool wholeHalo) const
+{
+    const int n = offsets_.size();
+    Faces faces{std::vector<int>(n, 0), std::vector<MPI_Datatype>(n, MPI_DOUBLE), std::vector<MPI_Datatype>(n, MPI_DOUBLE)};
+    for(int neighbour = 0; neighbour < n; neighbour++)
+    {
+        const std::array<int, 3> &offset = offsets_[neighbour];
+        if(!wholeHalo && (offset[0] != 0) + (offset[1] != 0) + (offset[2] != 0) != 1)
+            continue;
+        faces.counts[neighbour] = 1;
+        faces.send[neighbour] = createFaceType(discretization_->p().size(), offset, false);
+        faces.recv[neighbour] = createFaceType(discretization_->p().size(), offset, true);
+        MPI_Type_commit(&faces.send[neighbour]);
+        MPI_Type_commit(&faces.recv[neighbour]);
+    }
+    return faces;
+}
+
+NeighbourhoodExchange::Faces NeighbourhoodExchange::createFaces(FieldVariable &x, FieldVariable &y, FieldVariable &z) const
+{
+    std::array<MPI_Aint, 3> addresses;
+    MPI_Get_address(x.data(), &addresses[0]);
+    MPI_Get_address(y.data(), &addresses[1]);
+    MPI_Get_address(z.data(), &addresses[2]);
+    const std::array<int, 3> blockLengths{1, 1, 1};
+
+    const int n = offsets_.size();
+    Faces faces{std::vector<int>(n, 1), std::vector<MPI_Datatype>(n), std::vector<MPI_Datatype>(n)};
+    for(int neighbour = 0; neighbour < n; neighbour++)
+    {
+        const std::array<int, 3> &offset = offsets_[neighbour];
+        for(bool recv : {false, true})
+        {
+            std::array<MPI_Datatype, 3> fieldFaces{createFaceType(x.size(), offset, recv),
+                                                   createFaceType(y.size(), offset, recv),
+                                                   createFaceType(z.size(), offset, recv)};
+            MPI_Datatype &type = recv ? faces.recv[neighbour] : faces.send[neighbour];
+            MPI_Type_create_struct(3, blockLengths.data(), addresses.data(), fieldFaces.data(), &type);
+            MPI_Type_commit(&type);
+            for(MPI_Datatype &fieldFace : fieldFaces)
+                MPI_Type_free(&fieldFace);
+        }
+    }
+    return faces;
+}
+
+void NeighbourhoodExchange::freeFaces(Faces &faces)
+{
+    const int n = offsets_.size();
+    for(int neighbour = 0; neighbour < n; neighbour++)
+    {
+        if(faces.counts[neighbour] == 0)
+            continue;
+        MPI_Type_free(&faces.send[neighbour]);
+        MPI_Type_free(&faces.recv[neighbour]);
+    }
+}
+
+void NeighbourhoodExchange::start(void *buffer, const Faces &faces)
+{
+    assert(request_ == MPI_REQUEST_NULL);
+    // the sent and received parts are disjoint, so the field is the send and the receive buffer
+    MPI_Ineighbor_alltoallw(buffer, faces.counts.data(), displacements_.data(), faces.send.data(),
+                            buffer, faces.counts.data(), displacements_.data(), faces.recv.data(), comm_, &request_);
+}
+
+void NeighbourhoodExchange::startCellField(FieldVariable &field)
+{
+    assert(field.size() == discretization_->p().size());
+    start(field.data(), &field == &discretization_->p() ? pFaces_ : cellFaces_);
+}
+
+void NeighbourhoodExchange::startUVW()
+{
+    start(MPI_BOTTOM, uvwFaces_);
+}
+
+void NeighbourhoodExchange::startFGH()
+{
+    start(MPI_BOTTOM, fghFaces_);
+}
+
+void NeighbourhoodExchange::finish()
+{
+    MPI_Wait(&request_, MPI_STATUS_IGNORE);
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <memory>
+#include <vector>
+#include <sstream>
+#include <mpi.h>
+#include "discretization/discretization.h"
+#include "discretization/partition_information.h"
+#include "storage/field_variable.h"
+
+//! Exchanges the whole halo of a field with one MPI_Ineighbor_alltoallw, instead of a point-to-point message per
+//! neighbour. MPI sees the whole halo at once and chooses the transport for each neighbour, e.g. shared memory for
+//! the neighbours on the same node.
+//! The faces are sent from the fields and received into the ghost layers in place. All directions are in flight
+//! together, so a face can not pass on the ghost layers of the other directions like the in place exchange of the
+//! neighbours does. Instead the neighbourhood also contains the partitions across the edges, which send the edges
+//! of the halo, that the convective terms of F, G and H read, and the corners, that the output interpolates p
+//! from. The faces leave out the ghost layers towards the
+//! other neighbours, so all sent and received parts of a field are disjoint.
+//! The Dirichlet ghost layers are part of the faces, they have to be set before the exchange starts.
+class NeighbourhoodExchange
+{
+public:
+    //! the communicator of pi has to be the Cartesian one of the partitions, collective
+    NeighbourhoodExchange(std::shared_ptr<Discretization> discretization, const PartitionInformation &pi);
+
+    //! frees the face datatypes and the communicator
+    ~NeighbourhoodExchange();
+
+    //! The start functions post the collective, the fields may not be changed until finish completed it.
+    //! Only one exchange may be pending at a time. The cell field has to have the size of p. p gets the whole halo
+    //! for the output, the other cell fields only need the faces for the 7-point stencil.
+    void startCellField(FieldVariable &field);
+    void startUVW();
+    void startFGH();
+    void finish();
+
+    //! number of partitions across the faces, edges and corners
+    inline int nNeighbours() const { return offsets_.size(); }
+
+private:
+    //! count and datatype of the part of the field sent to and received from each neighbour, MPI_DOUBLE with count 0,
+    //! if nothing is sent
+    struct Faces
+    {
+        std::vector<int> counts;
+        std::vector<MPI_Datatype> send;
+        std::vector<MPI_Datatype> recv;
+    };
+
+    //! uncommitted subarray of the cells next to the neighbour at offset (recv = false) or of the ghost cells
+    //! (recv = true), along the directions without offset it leaves out the ghost layers towards neighbours
+    MPI_Datatype createFaceType(const std::array<int, 3> &size, const std::array<int, 3> &offset, bool recv) const;
+    //! faces, or with wholeHalo also the edges and corners, of the fields with the size of p, relative to the start
+    //! of the field
+    Faces createCellFaces(bool wholeHalo) const;
+    //! faces, edges and corners of three fields in one struct at their absolute addresses
+    Faces createFaces(FieldVariable &x, FieldVariable &y, FieldVariable &z) const;
+    void freeFaces(Faces &faces);
+
+    void start(void *buffer, const Faces &faces);
+
+    const std::shared_ptr<Discretization> discretization_;
+    //! 1 towards a neighbour and 0 at a Dirichlet boundary, at the lower and upper side of each direction
+    const ShellWidth neighbours_;
+    //! distributed graph of the partitions with their neighbours in the order of offsets_, the ranks are the same
+    //! as in the Cartesian communicator
+    MPI_Comm comm_ = MPI_COMM_NULL;
+    //! direction {x, y, z} of each neighbour, at least one of the entries is -1 or 1
+    std::vector<std::array<int, 3>> offsets_;
+    //! the datatypes are relative to the buffer, so all displacements are 0
+    std::vector<MPI_Aint> displacements_;
+
+    Faces cellFaces_;
+    Faces pFaces_;
+    Faces uvwFaces_;
+    Faces fghFaces_;
+
+    MPI_Request request_ = MPI_REQUEST_NULL;
+};
@@ -7,7 +7,7 @@ void runComputation(const Settings &settings, int rank, int nRanks)
                                     settings.physicalSize[1]/settings.nCells[1],
                                     settings.physicalSize[2]/settings.nCells[2]};
     // generate partition information
-    PartitionInformation pi(settings.nCells, meshWidth, rank, nRanks);
+    PartitionInformation pi(settings.nCells, meshWidth, MPI_COMM_WORLD);
     
     std::shared_ptr<Discretization> discretization;
     if(settings.useDonorCell == true)
@@ -46,18 +46,54 @@ void runComputation(const Settings &settings, int rank, int nRanks)
         
         simulationTime = simulationTime + deltaT;
         
-        partition->calculateFGH(deltaT);
+        if(settings.useOverlappedComm)
+        {
+            // the faces of f, g and h are sent, while the interior and its rhs are calculated,
+            // the rhs of the shell needs the boundary values
+            partition->calculateFGH(deltaT, GridRegion::Shell);
+            partition->startBoundaryFGH();
+            if(settings.useFusedKernels)
+                partition->calculateFGHAndRHS(deltaT, GridRegion::Interior);
+            else
+            {
+                partition->calculateFGH(deltaT, GridRegion::Interior);
+                partition->calculateRHS(deltaT, GridRegion::Interior);
+            }
+            partition->finishBoundaryFGH();
+            partition->calculateRHS(deltaT, GridRegion::Shell);
+        }
+        else if(settings.useFusedKernels)
+        {
+            // the rhs at the faces of the partition needs the boundary values of f, g and h
+            partition->calculateFGHAndRHS(deltaT);
+            partition->setBoundaryFGH();
+            partition->calculateBoundaryRHS(deltaT);
+        }
+        else
+        {
+            partition->calculateFGH(deltaT);
 
-        partition->setBoundaryFGH();
+            partition->setBoundaryFGH();
 
-        partition->calculateRHS(deltaT);
+            partition->calculateRHS(deltaT);
+        }
 
+        pressureSolver->extrapolateInitialGuess(deltaT);
         pressureSolver->solve(deltaT);
 
-        partition->calculateUVW(deltaT);
-
         // necassary for correct output files
-        partition->exchangeUVW();
+        if(settings.useOverlappedComm)
+        {
+            partition->calculateUVW(deltaT, GridRegion::Shell);
+            partition->startExchangeUVW();
+            partition->calculateUVW(deltaT, GridRegion::Interior);
+            partition->finishExchangeUVW();
+        }
+        else
+        {
+            partition->calculateUVW(deltaT);
+            partition->exchangeUVW();
+        }
 
         #ifndef NDEBUG
         if(rank == 0)
@@ -91,13 +127,21 @@ void runComputation(const Settings &settings, int rank, int nRanks)
     double rankDtTimer = dt.timer_.getCummulatedTime();
     double rankNeighbourTimer =  partition->timer_.getCummulatedTime();
     double rankSolverTimer = pressureSolver->timer_.getCummulatedTime();
+    double rankSavedSolverTimer = pressureSolver->estimateSavedResiduumTime();
     
     double summedDtTimer;
     double summedNeighbourTimer;
     double summedSolverTimer;
+    double summedSavedSolverTimer;
     MPI_Allreduce(&rankDtTimer, &summedDtTimer, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
     MPI_Allreduce(&rankNeighbourTimer, &summedNeighbourTimer, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
     MPI_Allreduce(&rankSolverTimer, &summedSolverTimer, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce(&rankSavedSolverTimer, &summedSavedSolverTimer, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    // the idle time differs between the ranks, e.g. the inner ranks wait for more neighbours, so it is not averaged
+    const std::array<double, 2> rankHaloTimers{partition->idleTimer_.getCummulatedTime(),
+                                               partition->unpackTimer_.getCummulatedTime()};
+    std::vector<double> haloTimers(2 * nRanks);
+    MPI_Gather(rankHaloTimers.data(), 2, MPI_DOUBLE, haloTimers.data(), 2, MPI_DOUBLE, 0, MPI_COMM_WORLD);
     if(rank == 0)
     {
         std::stringstream timeInfoStr;
@@ -109,7 +153,12 @@ void runComputation(const Settings &settings, int rank, int nRanks)
         timeInfoStr << "Times are means of the cummulated times all ranks recorded:\n";
         timeInfoStr << "Dt timer: " << summedDtTimer/(double)nRanks << "s.\n";
         timeInfoStr << "Neighbour timer: " << summedNeighbourTimer/(double)nRanks << "s.\n";
-        timeInfoStr << "Solver residuum timer: " << summedSolverTimer/(double)nRanks << "s.\n\n";
+        for(int r = 0; r < nRanks; r++)
+            timeInfoStr << "  rank " << r << " waited " << haloTimers[2*r] << "s for and unpacked "
+                        << haloTimers[2*r+1] << "s the faces of its neighbours\n";
+        timeInfoStr << "Solver residuum timer: " << summedSolverTimer/(double)nRanks << "s.\n";
+        timeInfoStr << "Solver residuum time saved by skipped and sweep checks (estimate): " 
+                    << summedSavedSolverTimer/(double)nRanks << "s.\n\n";
         std::cout << timeInfoStr.str();
     }
     #endif
@@ -117,14 +166,70 @@ void runComputation(const Settings &settings, int rank, int nRanks)
 
 std::shared_ptr<PressureSolver> newPressureSolver(std::shared_ptr<PartitionShell> partition, const Settings &settings, int nRanks)
 {
-    if(settings.pressureSolver == "SOR")
-        return std::make_shared<SOR>(partition, settings.epsilon, settings.maximumNumberOfIterations, settings.omega);
+    std::shared_ptr<PressureSolver> pressureSolver;
+    if(settings.useMixedPrecision && (settings.pressureSolver == "SOR" || settings.pressureSolver == "Checkerboard"))
+    {
+        // the inner sweeps restart from 0 in each step, so only the optimum of the grid is used
+        const std::shared_ptr<Discretization> discretization = partition->getDiscretization();
+        const double omega = settings.autoOmega ? AutoOmega::theoreticalOptimum(partition->pi_, discretization->dx2(), 
+                                                                                discretization->dy2(), discretization->dz2()) 
+                                                : settings.omega;
+        pressureSolver = std::make_shared<MixedPrecision>(partition, settings.epsilon, settings.maximumNumberOfIterations, 
+                                                          omega, settings.mixedPrecisionInnerIterations,
+                                                          settings.pressureSolver == "SOR" ? MixedPrecisionSmoother::SOR 
+                                                                                           : MixedPrecisionSmoother::Checkerboard);
+    }
+    else if(settings.pressureSolver == "SOR")
+        pressureSolver = std::make_shared<SOR>(partition, settings.epsilon, settings.maximumNumberOfIterations, settings.omega,
+                                               settings.autoOmega);
     else if(settings.pressureSolver == "GaussSeidel")
-        return std::make_shared<GaussSeidel>(partition, settings.epsilon, settings.maximumNumberOfIterations);
+        pressureSolver = std::make_shared<GaussSeidel>(partition, settings.epsilon, settings.maximumNumberOfIterations);
+    else if(settings.pressureSolver == "Checkerboard" && settings.haloDepth > 1)
+        pressureSolver = std::make_shared<DeepHaloCheckerboard>(partition, settings.epsilon, settings.maximumNumberOfIterations, 
+                                                                settings.omega, settings.haloDepth, settings.autoOmega);
     else if(settings.pressureSolver == "Checkerboard")
-        return std::make_shared<Checkerboard>(partition, settings.epsilon, settings.maximumNumberOfIterations, settings.omega);
+        pressureSolver = std::make_shared<Checkerboard>(partition, settings.epsilon, settings.maximumNumberOfIterations, settings.omega,
+                                                        settings.autoOmega);
+    else if(settings.pressureSolver == "Multigrid")
+        pressureSolver = std::make_shared<Multigrid>(partition, settings);
+    else if(settings.pressureSolver == "CG")
+        pressureSolver = std::make_shared<PCG>(partition, settings.epsilon, settings.maximumNumberOfIterations, Preconditioner::None, settings.omega);
+    else if(settings.pressureSolver == "PCG" || settings.pressureSolver == "MGCG")
+    {
+        // MGCG is PCG preconditioned by one multigrid V-cycle
+        const Preconditioner preconditioner = (settings.pressureSolver == "MGCG") ? Preconditioner::Multigrid
+                                                                                  : parsePreconditioner(settings.preconditioner);
+        std::shared_ptr<Multigrid> multigrid;
+        if(preconditioner == Preconditioner::Multigrid)
+            multigrid = std::make_shared<Multigrid>(partition, settings);
+        pressureSolver = std::make_shared<PCG>(partition, settings.epsilon, settings.maximumNumberOfIterations, 
+                                               preconditioner, settings.omega, multigrid);
+    }
+    else if(settings.pressureSolver == "PipelinedCG")
+        pressureSolver = std::make_shared<PipelinedCG>(partition, settings.epsilon, settings.maximumNumberOfIterations, 
+                                                       parsePreconditioner(settings.preconditioner), settings.omega);
+    else if(settings.pressureSolver == "WavefrontSOR" || settings.pressureSolver == "WavefrontCheckerboard")
+        pressureSolver = std::make_shared<WavefrontSOR>(partition, settings.epsilon, settings.maximumNumberOfIterations, settings.omega,
+                                                        settings.wavefrontSweeps, settings.pressureSolver == "WavefrontCheckerboard");
+    else if(settings.pressureSolver == "LineSOR")
+        pressureSolver = std::make_shared<LineSOR>(partition, settings.epsilon, settings.maximumNumberOfIterations, settings.omega,
+                                                   settings.lineDirection);
+    else if(settings.pressureSolver == "BlockJacobi")
+        pressureSolver = std::make_shared<BlockJacobi>(partition, settings.epsilon, settings.maximumNumberOfIterations);
+    else if(settings.pressureSolver == "Chebyshev")
+        pressureSolver = std::make_shared<Chebyshev>(partition, settings.epsilon, settings.maximumNumberOfIterations,
+                                                     settings.chebyshevLowerBoundFraction);
+    else if(settings.pressureSolver == "FFT")
+        pressureSolver = std::make_shared<FFTPoisson>(partition, settings.epsilon, settings.maximumNumberOfIterations);
     else
         throw std::invalid_argument("Invalid or non-implemented pressure solver: " + settings.pressureSolver + ", stop simulation\n.");
+
+    pressureSolver->setResiduumCheckInterval(settings.residuumCheckInterval);
+    pressureSolver->setUseSweepResiduum(settings.useSweepResiduum);
+    pressureSolver->setUseNonBlockingResiduum(settings.useNonBlockingResiduum);
+    pressureSolver->setExtrapolationOrder(settings.pressureExtrapolationOrder);
+    pressureSolver->setUseOverlappedComm(settings.useOverlappedComm);
+    return pressureSolver;
 }
 
 std::pair<double, bool> DtCalculator::calculate(double simulationTime)
@@ -135,7 +240,7 @@ std::pair<double, bool> DtCalculator::calculate(double simulationTime)
 
     double deltaLocal = std::min(dtConstant_, partition_->calculateVelocityDelta());
     double deltaT;
-    MPI_Allreduce(&deltaLocal, &deltaT, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+    MPI_Allreduce(&deltaLocal, &deltaT, 1, MPI_DOUBLE, MPI_MIN, partition_->pi_.comm());
 
     //! time to next full second (or sim end) for paraview output
     double deltaOut = nextParaviewTime_ - simulationTime;
@@ -22,6 +22,16 @@
 #include "pressure_solver/gauss_seidel.h"
 #include "pressure_solver/sor.h"
 #include "pressure_solver/checkerboard.h"
+#include "pressure_solver/multigrid.h"
+#include "pressure_solver/pcg.h"
+#include "pressure_solver/pipelined_cg.h"
+#include "pressure_solver/fft_poisson.h"
+#include "pressure_solver/mixed_precision.h"
+#include "pressure_solver/chebyshev.h"
+#include "pressure_solver/deep_halo_checkerboard.h"
+#include "pressure_solver/wavefront_sor.h"
+#include "pressure_solver/line_sor.h"
+#include "pressure_solver/block_jacobi.h"
 
 //! only a small class intended to facilitate calculation and statistics about dt
 class DtCalculator
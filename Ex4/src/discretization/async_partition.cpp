@@ -3,7 +3,7 @@
 AsyncPartition::AsyncPartition(const std::shared_ptr<Discretization> discretization,
                                const Settings &settings,
                                const PartitionInformation &pi) :
-                               PartitionShell(discretization, pi)
+                               PartitionShell(discretization, pi), datatypeHalos_(settings.useDatatypeHalos)
 {
     assert(discretization != nullptr);
 
@@ -14,13 +14,13 @@ AsyncPartition::AsyncPartition(const std::shared_ptr<Discretization> discretizat
         if(pi.ownBottomBoundary())
             fixBoundaries_.push_back(std::make_shared<DirichletBottom>(discretization, settings.dirichletBcBottom));
         else
-            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourBottom>(discretization, pi.bottomRank(),
+            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourBottom>(discretization, pi.bottomRank(), pi.comm(),
                                 !pi.ownLeftBoundary(), !pi.ownRightBoundary(), !pi.ownHindBoundary(), !pi.ownFrontBoundary()));
 
         if(pi.ownTopBoundary())
             fixBoundaries_.push_back(std::make_shared<DirichletTop>(discretization, settings.dirichletBcTop));
         else
-            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourTop>(discretization, pi.topRank(),
+            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourTop>(discretization, pi.topRank(), pi.comm(),
                                 !pi.ownLeftBoundary(), !pi.ownRightBoundary(), !pi.ownHindBoundary(), !pi.ownFrontBoundary()));
     }
     else
@@ -28,13 +28,13 @@ AsyncPartition::AsyncPartition(const std::shared_ptr<Discretization> discretizat
         if(pi.ownTopBoundary())
             fixBoundaries_.push_back(std::make_shared<DirichletTop>(discretization, settings.dirichletBcTop));
         else
-            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourTop>(discretization, pi.topRank(),
+            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourTop>(discretization, pi.topRank(), pi.comm(),
                                 !pi.ownLeftBoundary(), !pi.ownRightBoundary(), !pi.ownHindBoundary(), !pi.ownFrontBoundary()));
 
         if(pi.ownBottomBoundary())
             fixBoundaries_.push_back(std::make_shared<DirichletBottom>(discretization, settings.dirichletBcBottom));
         else
-            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourBottom>(discretization, pi.bottomRank(),
+            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourBottom>(discretization, pi.bottomRank(), pi.comm(),
                                 !pi.ownLeftBoundary(), !pi.ownRightBoundary(), !pi.ownHindBoundary(), !pi.ownFrontBoundary()));
     }
 
@@ -43,24 +43,24 @@ AsyncPartition::AsyncPartition(const std::shared_ptr<Discretization> discretizat
         if(pi.ownLeftBoundary())
             fixBoundaries_.push_back(std::make_shared<DirichletLeft> (discretization, settings.dirichletBcLeft));
         else
-            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourLeft> (discretization, pi.leftRank()));
+            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourLeft> (discretization, pi.leftRank(), pi.comm()));
 
         if(pi.ownRightBoundary())
             fixBoundaries_.push_back(std::make_shared<DirichletRight> (discretization, settings.dirichletBcRight));
         else
-            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourRight> (discretization, pi.rightRank()));
+            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourRight> (discretization, pi.rightRank(), pi.comm()));
     }
     else
     {
         if(pi.ownRightBoundary())
             fixBoundaries_.push_back(std::make_shared<DirichletRight> (discretization, settings.dirichletBcRight));
         else
-            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourRight> (discretization, pi.rightRank()));
+            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourRight> (discretization, pi.rightRank(), pi.comm()));
 
         if(pi.ownLeftBoundary())
             fixBoundaries_.push_back(std::make_shared<DirichletLeft> (discretization, settings.dirichletBcLeft));
         else
-            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourLeft> (discretization, pi.leftRank()));
+            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourLeft> (discretization, pi.leftRank(), pi.comm()));
     }
 
     if(pi.getPartPosZ() & 0b1)
@@ -68,13 +68,13 @@ AsyncPartition::AsyncPartition(const std::shared_ptr<Discretization> discretizat
         if(pi.ownFrontBoundary())
             fixBoundaries_.push_back(std::make_shared<DirichletFront> (discretization, settings.dirichletBcFront));
         else
-            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourFront> (discretization, pi.frontRank(), 
+            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourFront> (discretization, pi.frontRank(), pi.comm(), 
                                         !pi.ownLeftBoundary(), !pi.ownRightBoundary()));
 
         if(pi.ownHindBoundary())
             fixBoundaries_.push_back(std::make_shared<DirichletHind> (discretization, settings.dirichletBcHind));
         else
-            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourHind> (discretization, pi.hindRank(), 
+            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourHind> (discretization, pi.hindRank(), pi.comm(), 
                                         !pi.ownLeftBoundary(), !pi.ownRightBoundary()));
     }
     else
@@ -82,13 +82,13 @@ AsyncPartition::AsyncPartition(const std::shared_ptr<Discretization> discretizat
         if(pi.ownHindBoundary())
             fixBoundaries_.push_back(std::make_shared<DirichletHind> (discretization, settings.dirichletBcHind));
         else
-            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourHind> (discretization, pi.hindRank(), 
+            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourHind> (discretization, pi.hindRank(), pi.comm(), 
                                         !pi.ownLeftBoundary(), !pi.ownRightBoundary()));
 
         if(pi.ownFrontBoundary())
             fixBoundaries_.push_back(std::make_shared<DirichletFront> (discretization, settings.dirichletBcFront));
         else
-            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourFront> (discretization, pi.frontRank(), 
+            asyncNeighbours_.push_back(std::make_shared<AsyncNeighbourFront> (discretization, pi.frontRank(), pi.comm(), 
                                         !pi.ownLeftBoundary(), !pi.ownRightBoundary()));
     }
 
@@ -107,12 +107,39 @@ AsyncPartition::AsyncPartition(const std::shared_ptr<Discretization> discretizat
     }
     // each direction should be unique and as such should have each an entry in the set
     assert(directions.size() == 6);
+
+    for(std::shared_ptr<AsyncNeighbourBoundary> neighbour : asyncNeighbours_)
+    {
+        if(datatypeHalos_)
+            neighbour->createFaceTypes();
+        if(settings.usePersistentComm)
+            neighbour->mpiHandler_.usePersistentRequests();
+    }
+    if(settings.useNeighbourCollectives)
+        neighbourhood_ = std::make_shared<NeighbourhoodExchange>(discretization, pi);
 }
 
 // First this method sets up async receive, sends its data
 // then it sets the dirichlet boundary, finally setting the first incoming ghost data
 void AsyncPartition::setBoundaryUVW()
 {
+    // the faces are sent from the fields themselves including the Dirichlet ghost layers, so these are set first
+    if(neighbourhood_)
+    {
+        fixDirichletBoundary();
+        startNeighbourhoodExchange([](NeighbourhoodExchange &neighbourhood) { neighbourhood.startUVW(); });
+        finishNeighbourhoodExchange();
+        return;
+    }
+    if(datatypeHalos_)
+    {
+        for(std::shared_ptr<Dirichlet> fixBoundary : fixBoundaries_)
+        {
+            fixBoundary->setUVW();
+        }
+        exchangeInPlace([](AsyncNeighbourBoundary &neighbour) { neighbour.exchangeUVWInPlace(); });
+        return;
+    }
     std::vector<std::shared_ptr<AsyncNeighbourBoundary>> neighbourRecvQueue;
     setupExchange(neighbourRecvQueue, &AsyncNeighbourBoundary::exchangeUVW);
     for(std::shared_ptr<Dirichlet> fixBoundary : fixBoundaries_)
@@ -124,36 +151,193 @@ void AsyncPartition::setBoundaryUVW()
 
 void AsyncPartition::setBoundaryFGH()
 {
-    std::vector<std::shared_ptr<AsyncNeighbourBoundary>> neighbourRecvQueue;
-    setupExchange(neighbourRecvQueue, &AsyncNeighbourBoundary::exchangeFGH);
+    startBoundaryFGH();
+    finishBoundaryFGH();
+}
+
+void AsyncPartition::startBoundaryFGH()
+{
+    if(neighbourhood_)
+    {
+        for(std::shared_ptr<Dirichlet> fixBoundary : fixBoundaries_)
+        {
+            fixBoundary->setFGH();
+        }
+        startNeighbourhoodExchange([](NeighbourhoodExchange &neighbourhood) { neighbourhood.startFGH(); });
+        return;
+    }
+    if(!datatypeHalos_)
+    {
+        assert(pendingRecvQueue_.empty());
+        setupExchange(pendingRecvQueue_, &AsyncNeighbourBoundary::exchangeFGH);
+    }
+    // the interior reads the Dirichlet ghost layers, so they are set during the exchange
     for(std::shared_ptr<Dirichlet> fixBoundary : fixBoundaries_)
     {
         fixBoundary->setFGH();
     }
-    setFirstIncomingData(neighbourRecvQueue, &AsyncNeighbourBoundary::setRecvFGH);
+}
+
+void AsyncPartition::finishBoundaryFGH()
+{
+    if(neighbourhood_)
+    {
+        finishNeighbourhoodExchange();
+        return;
+    }
+    if(datatypeHalos_)
+    {
+        exchangeInPlace([](AsyncNeighbourBoundary &neighbour) { neighbour.exchangeFGHInPlace(); });
+        return;
+    }
+    setFirstIncomingData(pendingRecvQueue_, &AsyncNeighbourBoundary::setRecvFGH);
 }
 
 void AsyncPartition::setBoundaryP()
+{
+    setBoundaryCellField(discretization_->p());
+}
+
+void AsyncPartition::exchangeP()
+{
+    exchangeCellField(discretization_->p());
+}
+
+void AsyncPartition::setBoundaryCellField(FieldVariable &field)
+{
+    startBoundaryCellField(field);
+    finishBoundaryCellField(field);
+}
+
+void AsyncPartition::exchangeCellField(FieldVariable &field)
+{
+    startExchangeCellField(field);
+    finishExchangeCellField(field);
+}
+
+void AsyncPartition::startBoundaryCellField(FieldVariable &field)
+{
+    // the packed faces are sent, before the Dirichlet ghost layers are set, the in place ones afterwards
+    if(!inNeighbourhood(field))
+        startExchangeCellField(field);
+    for(std::shared_ptr<Dirichlet> fixBoundary : fixBoundaries_)
+    {
+        fixBoundary->setCellField(field);
+    }
+    if(inNeighbourhood(field))
+        startExchangeCellField(field);
+}
+
+void AsyncPartition::finishBoundaryCellField(FieldVariable &field)
+{
+    finishExchangeCellField(field);
+}
+
+void AsyncPartition::startExchangeCellField(FieldVariable &field)
+{
+    if(inNeighbourhood(field))
+    {
+        startNeighbourhoodExchange([&field](NeighbourhoodExchange &neighbourhood) { neighbourhood.startCellField(field); });
+        return;
+    }
+    if(datatypeHalos_ && field.size() == discretization_->p().size())
+        return;
+    assert(pendingRecvQueue_.empty());
+    setupExchange(pendingRecvQueue_, &AsyncNeighbourBoundary::exchangeCellField, field);
+}
+
+void AsyncPartition::finishExchangeCellField(FieldVariable &field)
+{
+    if(inNeighbourhood(field))
+    {
+        finishNeighbourhoodExchange();
+        return;
+    }
+    if(datatypeHalos_ && field.size() == discretization_->p().size())
+    {
+        exchangeInPlace([&field](AsyncNeighbourBoundary &neighbour) { neighbour.exchangeCellFieldInPlace(field); });
+        return;
+    }
+    setFirstIncomingData(pendingRecvQueue_, &AsyncNeighbourBoundary::setRecvCellField, field);
+}
+
+void AsyncPartition::setBoundaryCellField(FloatArray3D &field)
 {
     std::vector<std::shared_ptr<AsyncNeighbourBoundary>> neighbourRecvQueue;
-    setupExchange(neighbourRecvQueue, &AsyncNeighbourBoundary::exchangeP);
+    setupExchange(neighbourRecvQueue, &AsyncNeighbourBoundary::exchangeCellField, field);
     for(std::shared_ptr<Dirichlet> fixBoundary : fixBoundaries_)
     {
-        fixBoundary->setP();
+        fixBoundary->setCellField(field);
     }
-    setFirstIncomingData(neighbourRecvQueue, &AsyncNeighbourBoundary::setRecvP);
+    setFirstIncomingData(neighbourRecvQueue, &AsyncNeighbourBoundary::setRecvCellField, field);
 }
 
-void AsyncPartition::exchangeP()
+void AsyncPartition::exchangeCellField(FloatArray3D &field)
 {
     std::vector<std::shared_ptr<AsyncNeighbourBoundary>> neighbourRecvQueue;
-    setupExchange(neighbourRecvQueue, &AsyncNeighbourBoundary::exchangeP);
-    setFirstIncomingData(neighbourRecvQueue, &AsyncNeighbourBoundary::setRecvP);
+    setupExchange(neighbourRecvQueue, &AsyncNeighbourBoundary::exchangeCellField, field);
+    setFirstIncomingData(neighbourRecvQueue, &AsyncNeighbourBoundary::setRecvCellField, field);
+}
+
+void AsyncPartition::exchangeDeepCellField(Array3D &field, int depth)
+{
+    setDirichletDeepCellField(field, depth);
+    // each direction sends the ghost layers of the directions before, which fills the edges and corners of the halo
+    const std::array<std::array<BoundaryEdge, 2>, 3> axisEdges{{{BoundaryEdge::LEFT, BoundaryEdge::RIGHT},
+                                                                {BoundaryEdge::BOTTOM, BoundaryEdge::TOP},
+                                                                {BoundaryEdge::HIND, BoundaryEdge::FRONT}}};
+    for(const std::array<BoundaryEdge, 2> &edges : axisEdges)
+    {
+        std::vector<std::shared_ptr<AsyncNeighbourBoundary>> neighbourRecvQueue;
+        #ifdef TIMER
+        timer_.setT0();
+        #endif
+        for(std::shared_ptr<AsyncNeighbourBoundary> neighbour : asyncNeighbours_)
+        {
+            if(neighbour->edge_ != edges[0] && neighbour->edge_ != edges[1])
+                continue;
+            neighbour->mpiHandler_.waitForSendComplete();
+            neighbour->exchangeDeepCellField(field, depth);
+            neighbourRecvQueue.push_back(neighbour);
+        }
+        completeReceives(neighbourRecvQueue,
+                         [&field, depth](AsyncNeighbourBoundary &neighbour) { neighbour.setRecvDeepCellField(field, depth); });
+        #ifdef TIMER
+        timer_.addTimeSinceT0();
+        #endif
+    }
 }
 
 void AsyncPartition::exchangeUVW()
 {
-    std::vector<std::shared_ptr<AsyncNeighbourBoundary>> neighbourRecvQueue;
-    setupExchange(neighbourRecvQueue, &AsyncNeighbourBoundary::exchangeUVW);
-    setFirstIncomingData(neighbourRecvQueue, &AsyncNeighbourBoundary::setRecvUVW);
-}
\ No newline at end of file
+    startExchangeUVW();
+    finishExchangeUVW();
+}
+
+void AsyncPartition::startExchangeUVW()
+{
+    if(neighbourhood_)
+    {
+        startNeighbourhoodExchange([](NeighbourhoodExchange &neighbourhood) { neighbourhood.startUVW(); });
+        return;
+    }
+    if(datatypeHalos_)
+        return;
+    assert(pendingRecvQueue_.empty());
+    setupExchange(pendingRecvQueue_, &AsyncNeighbourBoundary::exchangeUVW);
+}
+
+void AsyncPartition::finishExchangeUVW()
+{
+    if(neighbourhood_)
+    {
+        finishNeighbourhoodExchange();
+        return;
+    }
+    if(datatypeHalos_)
+    {
+        exchangeInPlace([](AsyncNeighbourBoundary &neighbour) { neighbour.exchangeUVWInPlace(); });
+        return;
+    }
+    setFirstIncomingData(pendingRecvQueue_, &AsyncNeighbourBoundary::setRecvUVW);
+}
@@ -11,6 +11,7 @@
 #include "boundary/boundary.h"
 #include "boundary/dirichlet.h"
 #include "boundary/async_neighbour_boundary.h"
+#include "boundary/neighbourhood_exchange.h"
 
 //! Class to encapsulate the discretization and its boundaries
 class AsyncPartition : public PartitionShell
@@ -27,9 +28,28 @@ public:
 
     //! only exchange the pressure values with the respective neighbours w/o setting dirichlet
     void exchangeP() override;
+    //! used by the Krylov solvers for their work vectors
+    void setBoundaryCellField(FieldVariable &field) override;
+    void exchangeCellField(FieldVariable &field) override;
+    //! single precision halos of the mixed precision pressure solver
+    void setBoundaryCellField(FloatArray3D &field) override;
+    void exchangeCellField(FloatArray3D &field) override;
+    //! the Neumann ghost layers are set first, so the neighbours also receive them in the edges of their halo
+    void exchangeDeepCellField(Array3D &field, int depth) override;
     //! used before paraview output
     void exchangeUVW() override;
 
+    //! the split exchanges keep the pending receives in pendingRecvQueue_, the in place exchange waits for each
+    //! direction before it sends the next one, so with useDatatypeHalos it is done completely by finish
+    void startBoundaryFGH() override;
+    void finishBoundaryFGH() override;
+    void startBoundaryCellField(FieldVariable &field) override;
+    void finishBoundaryCellField(FieldVariable &field) override;
+    void startExchangeCellField(FieldVariable &field) override;
+    void finishExchangeCellField(FieldVariable &field) override;
+    void startExchangeUVW() override;
+    void finishExchangeUVW() override;
+
     //! sets up the appropriate send and start-receive for all neighbours and pushes the 
     //! neighbours into the neighbourRecvQueue for later use
     inline void setupExchange(std::vector<std::shared_ptr<AsyncNeighbourBoundary>> &neighbourRecvQueue, 
@@ -40,6 +60,8 @@ public:
         #endif
         for(std::shared_ptr<AsyncNeighbourBoundary> neighbour : asyncNeighbours_)
         {
+            // the send buffers are reused, so the previous send has to be completed before packing
+            neighbour->mpiHandler_.waitForSendComplete();
             (neighbour.get()->*setupFun)();
             neighbourRecvQueue.push_back(neighbour);
         }
@@ -48,34 +70,184 @@ public:
         #endif
     }
 
-    //! this little function takes sets the data of the first incoming data 
+    //! same as above, but for the exchange of a cell field in double or single precision
+    template<typename Field>
+    inline void setupExchange(std::vector<std::shared_ptr<AsyncNeighbourBoundary>> &neighbourRecvQueue, 
+                              void (AsyncNeighbourBoundary::*setupFun)(Field &), Field &field)
+    {
+        #ifdef TIMER
+        timer_.setT0();
+        #endif
+        for(std::shared_ptr<AsyncNeighbourBoundary> neighbour : asyncNeighbours_)
+        {
+            neighbour->mpiHandler_.waitForSendComplete();
+            (neighbour.get()->*setupFun)(field);
+            neighbourRecvQueue.push_back(neighbour);
+        }
+        #ifdef TIMER
+        timer_.addTimeSinceT0();
+        #endif
+    }
+
+    //! Completion engine of the receives in neighbourRecvQueue: their requests are collected in one array and each
+    //! face is unpacked with unpack(neighbour) as soon as it arrived. Between MPI_Testsome calls work() is done
+    //! as long as it returns, that there is work left, afterwards the engine blocks in MPI_Waitsome, which
+    //! lets MPI progress the messages instead of spinning over the requests. The queue is empty afterwards.
+    template<typename Unpack, typename Work>
+    inline void completeReceives(std::vector<std::shared_ptr<AsyncNeighbourBoundary>> &neighbourRecvQueue,
+                                 Unpack unpack, Work work)
+    {
+        const int nRequests = neighbourRecvQueue.size();
+        std::vector<MPI_Request> requests(nRequests);
+        std::vector<int> completed(nRequests);
+        for(int r = 0; r < nRequests; r++)
+            requests[r] = neighbourRecvQueue[r]->mpiHandler_.recvRequest();
+
+        bool workLeft = true;
+        int nOpen = nRequests;
+        while(nOpen > 0)
+        {
+            int nCompleted;
+            #ifdef TIMER
+            idleTimer_.setT0();
+            #endif
+            if(workLeft)
+                MPI_Testsome(nRequests, requests.data(), &nCompleted, completed.data(), MPI_STATUSES_IGNORE);
+            else
+                MPI_Waitsome(nRequests, requests.data(), &nCompleted, completed.data(), MPI_STATUSES_IGNORE);
+            #ifdef TIMER
+            idleTimer_.addTimeSinceT0();
+            #endif
+            if(nCompleted == 0)
+            {
+                workLeft = work();
+                continue;
+            }
+
+            #ifdef TIMER
+            unpackTimer_.setT0();
+            #endif
+            for(int c = 0; c < nCompleted; c++)
+            {
+                const int r = completed[c];
+                neighbourRecvQueue[r]->mpiHandler_.recvRequest() = requests[r];
+                unpack(*neighbourRecvQueue[r]);
+            }
+            #ifdef TIMER
+            unpackTimer_.addTimeSinceT0();
+            #endif
+            nOpen -= nCompleted;
+        }
+        neighbourRecvQueue.clear();
+    }
+
+    //! same without other work, a first MPI_Testsome precedes the blocking MPI_Waitsome
+    template<typename Unpack>
+    inline void completeReceives(std::vector<std::shared_ptr<AsyncNeighbourBoundary>> &neighbourRecvQueue, Unpack unpack)
+    {
+        completeReceives(neighbourRecvQueue, unpack, []() { return false; });
+    }
+
+    //! this little function sets the data of the neighbours in the order it arrives
     inline void setFirstIncomingData(std::vector<std::shared_ptr<AsyncNeighbourBoundary>> &neighbourRecvQueue,
                                     void (AsyncNeighbourBoundary::*setFun)())
     {
-        // Although adding/removing elements is the domain of lists, the vector 
-        // datatype is so lightweight&in cache, that it is very likely to outpeform lists (for N very small).
-        // However it migt be interesting to test this hypothesis some time.
         #ifdef TIMER
         timer_.setT0();
         #endif
-        while(neighbourRecvQueue.size() > 0)
+        completeReceives(neighbourRecvQueue, [setFun](AsyncNeighbourBoundary &neighbour) { (neighbour.*setFun)(); });
+        #ifdef TIMER
+        timer_.addTimeSinceT0();
+        #endif
+    }
+
+    //! same as above, but for the exchange of a cell field in double or single precision
+    template<typename Field>
+    inline void setFirstIncomingData(std::vector<std::shared_ptr<AsyncNeighbourBoundary>> &neighbourRecvQueue,
+                                    void (AsyncNeighbourBoundary::*setFun)(Field &), Field &field)
+    {
+        #ifdef TIMER
+        timer_.setT0();
+        #endif
+        completeReceives(neighbourRecvQueue,
+                         [setFun, &field](AsyncNeighbourBoundary &neighbour) { (neighbour.*setFun)(field); });
+        #ifdef TIMER
+        timer_.addTimeSinceT0();
+        #endif
+    }
+
+    //! Exchanges the halos with the face datatypes of the neighbours, one direction after the other. Each direction
+    //! waits for its sends as well, so the faces are not changed while they are sent and the ghost layers of this
+    //! direction are complete, before they are sent on by the next one.
+    template<typename Start>
+    inline void exchangeInPlace(Start start)
+    {
+        #ifdef TIMER
+        timer_.setT0();
+        #endif
+        for(int axis = 0; axis < 3; axis++)
         {
-            for(int n = 0; n < neighbourRecvQueue.size(); n++)
+            std::vector<std::shared_ptr<AsyncNeighbourBoundary>> neighbourRecvQueue;
+            for(std::shared_ptr<AsyncNeighbourBoundary> neighbour : asyncNeighbours_)
             {
-                if(neighbourRecvQueue[n]->mpiHandler_.queryRecvComplete())
-                {
-                    (neighbourRecvQueue[n].get()->*setFun)();
-                    neighbourRecvQueue.erase(neighbourRecvQueue.begin() + n);
-                    break;
-                }
+                if(neighbour->axis() != axis)
+                    continue;
+                neighbour->mpiHandler_.waitForSendComplete();
+                start(*neighbour);
+                neighbourRecvQueue.push_back(neighbour);
             }
+            // the faces are received in place, there is nothing to unpack
+            completeReceives(neighbourRecvQueue,
+                             [](AsyncNeighbourBoundary &neighbour) { neighbour.mpiHandler_.waitForSendComplete(); });
         }
         #ifdef TIMER
         timer_.addTimeSinceT0();
         #endif
     }
 
+    //! starts the exchange of all faces with one neighbourhood collective, e.g. [](NeighbourhoodExchange &n) { n.startUVW(); }
+    template<typename Start>
+    inline void startNeighbourhoodExchange(Start start)
+    {
+        #ifdef TIMER
+        timer_.setT0();
+        #endif
+        start(*neighbourhood_);
+        #ifdef TIMER
+        timer_.addTimeSinceT0();
+        #endif
+    }
+
+    inline void finishNeighbourhoodExchange()
+    {
+        #ifdef TIMER
+        timer_.setT0();
+        idleTimer_.setT0();
+        #endif
+        neighbourhood_->finish();
+        #ifdef TIMER
+        idleTimer_.addTimeSinceT0();
+        timer_.addTimeSinceT0();
+        #endif
+    }
+
+    //! if the halo of the field is exchanged by the neighbourhood collective, otherwise by the neighbours
+    inline bool inNeighbourhood(const FieldVariable &field) const
+    {
+        return neighbourhood_ != nullptr && field.size() == discretization_->p().size();
+    }
+
 protected:
+    //! the halos of p, the fields of its size and of u, v, w, f, g and h are exchanged in place
+    const bool datatypeHalos_;
+
+    //! exchanges the same halos as the datatypes above with one neighbourhood collective each, if
+    //! useNeighbourCollectives is set, which takes precedence
+    std::shared_ptr<NeighbourhoodExchange> neighbourhood_;
+
+    //! neighbours of the split exchange between start and finish
+    std::vector<std::shared_ptr<AsyncNeighbourBoundary>> pendingRecvQueue_;
+
     //! Extra async neighbours vector, making them neighbour-derived migt solve this,
     //! but would remove neighbour specific virtual functions. One may solve this again by making
     //! a virtual SyncNeighbour class, but well...
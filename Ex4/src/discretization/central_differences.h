@@ -8,6 +8,16 @@ public:
   //! re-use the Discretization constructors
   using Discretization::Discretization;
 
+  //! preliminary velocities with the central flux inlined
+  void calculateFGH(double deltaT, GridRegion region = GridRegion::All) override
+  {
+    calculateFGHKernel(deltaT, CentralFlux(), false, region);
+  }
+  void calculateFGHAndRHS(double deltaT, GridRegion region = GridRegion::All) override
+  {
+    calculateFGHKernel(deltaT, CentralFlux(), true, region);
+  }
+
   double computeDuvDx(int i, int j, int k) const override;
   double computeDuvDy(int i, int j, int k) const override;
 
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cmath>
+
+// Policies of the convective terms for the statically dispatched FGH kernel of the Discretization.
+// Both schemes calculate the derivative of a product as the difference of the fluxes through two opposite faces,
+// a flux is the transporting velocity a at the face times the transported quantity q interpolated from both sides.
+
+//! central differences: the transported quantity is the mean of both sides
+struct CentralFlux
+{
+  inline double operator()(double a, double qMinus, double qPlus) const
+  {
+    return a * (qMinus + qPlus) / 2.;
+  }
+};
+
+//! donor cell: the central flux blended with the upwind flux by alpha
+struct DonorCellFlux
+{
+  const double alpha;
+
+  inline double operator()(double a, double qMinus, double qPlus) const
+  {
+    return a * (qMinus + qPlus) / 2. + alpha * std::abs(a) * (qMinus - qPlus) / 2.;
+  }
+};
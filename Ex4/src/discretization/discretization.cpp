@@ -6,12 +6,49 @@ Discretization::Discretization(PartitionInformation &pi, const Settings &setting
                                settings_(settings),
                                meshWidth2_({pi.meshWidth()[0]*pi.meshWidth()[0],
                                             pi.meshWidth()[1]*pi.meshWidth()[1],
-                                            pi.meshWidth()[2]*pi.meshWidth()[2]})
+                                            pi.meshWidth()[2]*pi.meshWidth()[2]}),
+                               shellWidth_({{!pi.ownLeftBoundary(), !pi.ownBottomBoundary(), !pi.ownHindBoundary()},
+                                            {!pi.ownRightBoundary(), !pi.ownTopBoundary(), !pi.ownFrontBoundary()}})
 {
   assert(pi.nCellsLocal()[0] > 0 && pi.nCellsLocal()[1] > 0 && pi.nCellsLocal()[2] > 0);
   assert(pi.meshWidth()[0]   > 0 && pi.meshWidth()[1]   > 0 && pi.meshWidth()[2]   > 0);
 }
 
+//! rhs of the cells [iBegin, iEnd) of the row (j,k) from the divergence of f, g and h
+static inline void rhsRow(const Array3DView &rhs, const Array3DView &f, const Array3DView &g, const Array3DView &h,
+                          int j, int k, int iBegin, int iEnd,
+                          double invDx, double invDy, double invDz, double invDeltaT)
+{
+  #pragma omp simd
+  for(int i = iBegin; i < iEnd; i++)
+  {
+    const double DfDx = (f(i,j,k) - f(i-1,j,  k))   * invDx;
+    const double DgDy = (g(i,j,k) - g(i,  j-1,k))   * invDy;
+    const double DhDz = (h(i,j,k) - h(i,  j,  k-1)) * invDz;
+    rhs(i,j,k) = (DfDx + DgDy + DhDz) * invDeltaT;
+  }
+}
+
+//! maximum over the ghost layers of a field, whose inner points are [0, n) in each direction
+static double maxOfGhostLayers(const ConstArray3DView &field, int iN, int jN, int kN)
+{
+  double maximum = std::numeric_limits<double>::lowest();
+  for(int k = -1; k < kN+1; k++)
+  {
+    for(int j = -1; j < jN+1; j++)
+    {
+      if(k == -1 || k == kN || j == -1 || j == jN)
+      {
+        for(int i = -1; i < iN+1; i++)
+          maximum = std::max(maximum, field(i,j,k));
+      }
+      else
+        maximum = std::max(maximum, std::max(field(-1,j,k), field(iN,j,k)));
+    }
+  }
+  return maximum;
+}
+
 //! calculate the deltaT depending on the velocity and mesh-width, includes boundaries
 double Discretization::calculateVelocityDelta() const
 {
@@ -19,38 +56,49 @@ double Discretization::calculateVelocityDelta() const
   double max_u = std::numeric_limits<double>::epsilon();
   double max_v = std::numeric_limits<double>::epsilon();
   double max_w = std::numeric_limits<double>::epsilon();
+  const ConstArray3DView u = uView(), v = vView(), w = wView();
+  if(settings_.useFusedKernels && interiorVelocityMaxValid_)
+  {
+    // the inner points are unchanged since calculateUVW, the boundaries only set the ghost layers
+    max_u = std::max(interiorVelocityMax_[0], maxOfGhostLayers(u, uiN(), ujN(), ukN()));
+    max_v = std::max(interiorVelocityMax_[1], maxOfGhostLayers(v, viN(), vjN(), vkN()));
+    max_w = std::max(interiorVelocityMax_[2], maxOfGhostLayers(w, wiN(), wjN(), wkN()));
+    return velocityDelta(max_u, max_v, max_w);
+  }
   // find the minimal delta t due to the fluid velocity
   // velocityDelta may be deactivated in settings by setting "disableAdaptiveDt=true"
-  #pragma omp simd collapse(3) reduction(max:max_u)
+  #pragma omp parallel for collapse(2) reduction(max:max_u)
   for(int k = -1; k < ukN()+1; k++)
   {
     for(int j = -1; j < ujN()+1; j++)
     {
+        #pragma omp simd reduction(max:max_u)
         for(int i = -1; i < uiN()+1; i++)
         {
             max_u = std::max(max_u, u(i,j,k));
         }
     }
   }
-  #pragma omp simd collapse(3) reduction(max:max_v)
+  #pragma omp parallel for collapse(2) reduction(max:max_v)
   for(int k = -1; k < vkN()+1; k++)
   {
     for(int j = -1; j < vjN()+1; j++)
     {
+        #pragma omp simd reduction(max:max_v)
         for(int i = -1; i < viN()+1; i++)
         {
             max_v = std::max(max_v, v(i,j,k));
         }
     }
   }
-  #pragma omp simd collapse(3) reduction(max:max_v)
+  #pragma omp parallel for collapse(2) reduction(max:max_w)
   for(int k = -1; k < wkN()+1; k++)
   {
     for(int j = -1; j < wjN()+1; j++)
     {
+        #pragma omp simd reduction(max:max_w)
         for(int i = -1; i < wiN()+1; i++)
         {
-          // max_v instead of max_w
             max_w = std::max(max_w, w(i,j,k));
         }
     }
@@ -58,6 +106,11 @@ double Discretization::calculateVelocityDelta() const
   #ifdef DEBUG_VELMAX
   std::cout << "max-u " << max_u << "\tmax-v " << max_v << "\tmax-w " << max_w << std::endl;
   #endif
+  return velocityDelta(max_u, max_v, max_w);
+}
+
+double Discretization::velocityDelta(double max_u, double max_v, double max_w) const
+{
   double dTx = dx() / max_u;
   double dTy = dy() / max_v;
   double dTz = dz() / max_w;
@@ -72,130 +125,228 @@ double Discretization::calculateReynoldsDelta() const
   return result;
 }
 
-//! calculate the preliminary velocities (f, g) and the rhs for pressure solver
-void Discretization::calculateFGH(double deltaT)
+//! calculate the preliminary velocities (f, g, h) with the convective terms of the scheme's flux
+template<typename Flux>
+void Discretization::calculateFGHKernel(double deltaT, const Flux &flux, bool withRHS, GridRegion region)
 {
-  // calculate f
-  #pragma omp simd collapse(3)
-  for(int k = 0; k < ukN(); k++)
+  // the same stencils as the computeD* methods, but on the views of the fields, so the flux is inlined
+  // and the rows over i vectorize
+  const double invDx = 1. / dx(), invDy = 1. / dy(), invDz = 1. / dz();
+  const double invDx2 = 1. / dx2(), invDy2 = 1. / dy2(), invDz2 = 1. / dz2();
+  const double invRe = 1. / settings_.re;
+  const Array3DView u = uView(), v = vView(), w = wView();
+  const Array3DView f = fView(), g = gView(), h = hView(), rhs = rhsView();
+
+  // f on the u points [iBegin, iEnd) of a row
+  auto fRow = [&](int j, int k, int iBegin, int iEnd)
   {
-    for(int j = 0; j < ujN(); j++)
+    #pragma omp simd
+    for(int i = iBegin; i < iEnd; i++)
     {
-        for(int i = 0; i < uiN(); i++)
-        {
-            const double D2uDx2 = computeD2uDx2(i,j,k);
-            const double D2uDy2 = computeD2uDy2(i,j,k);
-            const double D2uDz2 = computeD2uDz2(i,j,k);
-            const double Du2Dx  = computeDu2Dx (i,j,k);
-            const double DuvDy  = computeDuvDy (i,j,k);
-            const double DuwDz  = computeDuwDz (i,j,k);
-            f(i,j,k) = u(i,j,k) + deltaT*((D2uDx2+D2uDy2+D2uDz2)/settings_.re 
-              - Du2Dx - DuvDy - DuwDz + settings_.g[0]);
-        }
+      const double laplacian = (u(i+1,j,k) - 2*u(i,j,k) + u(i-1,j,k)) * invDx2
+                             + (u(i,j+1,k) - 2*u(i,j,k) + u(i,j-1,k)) * invDy2
+                             + (u(i,j,k+1) - 2*u(i,j,k) + u(i,j,k-1)) * invDz2;
+      const double Du2Dx = (flux((u(i,j,k) + u(i+1,j,k)) / 2., u(i,j,k), u(i+1,j,k))
+                          - flux((u(i-1,j,k) + u(i,j,k)) / 2., u(i-1,j,k), u(i,j,k))) * invDx;
+      const double DuvDy = (flux((v(i,j,k) + v(i+1,j,k)) / 2., u(i,j,k), u(i,j+1,k))
+                          - flux((v(i,j-1,k) + v(i+1,j-1,k)) / 2., u(i,j-1,k), u(i,j,k))) * invDy;
+      const double DuwDz = (flux((w(i,j,k) + w(i+1,j,k)) / 2., u(i,j,k), u(i,j,k+1))
+                          - flux((w(i,j,k-1) + w(i+1,j,k-1)) / 2., u(i,j,k-1), u(i,j,k))) * invDz;
+      f(i,j,k) = u(i,j,k) + deltaT*(laplacian*invRe - Du2Dx - DuvDy - DuwDz + settings_.g[0]);
     }
-  }
+  };
 
-  // calculate g
-  #pragma omp simd collapse(3)
-  for(int k = 0; k < vkN(); k++)
+  // g on the v points [iBegin, iEnd) of a row
+  auto gRow = [&](int j, int k, int iBegin, int iEnd)
   {
-    for(int j = 0; j < vjN(); j++)
+    #pragma omp simd
+    for(int i = iBegin; i < iEnd; i++)
     {
-        for(int i = 0; i < viN(); i++)
-        {
-            const double D2vDx2 = computeD2vDx2(i,j,k);
-            const double D2vDy2 = computeD2vDy2(i,j,k);
-            const double D2vDz2 = computeD2vDz2(i,j,k);
-            const double DuvDx  = computeDuvDx (i,j,k);
-            const double Dv2Dy  = computeDv2Dy (i,j,k);
-            const double DvwDz  = computeDvwDz (i,j,k);
-            g(i,j,k) = v(i,j,k) + deltaT*((D2vDx2+D2vDy2+D2vDz2)/settings_.re
-              - DuvDx- Dv2Dy - DvwDz + settings_.g[1]);
-        }
+      const double laplacian = (v(i+1,j,k) - 2*v(i,j,k) + v(i-1,j,k)) * invDx2
+                             + (v(i,j+1,k) - 2*v(i,j,k) + v(i,j-1,k)) * invDy2
+                             + (v(i,j,k+1) - 2*v(i,j,k) + v(i,j,k-1)) * invDz2;
+      const double DuvDx = (flux((u(i,j,k) + u(i,j+1,k)) / 2., v(i,j,k), v(i+1,j,k))
+                          - flux((u(i-1,j,k) + u(i-1,j+1,k)) / 2., v(i-1,j,k), v(i,j,k))) * invDx;
+      const double Dv2Dy = (flux((v(i,j,k) + v(i,j+1,k)) / 2., v(i,j,k), v(i,j+1,k))
+                          - flux((v(i,j-1,k) + v(i,j,k)) / 2., v(i,j-1,k), v(i,j,k))) * invDy;
+      const double DvwDz = (flux((w(i,j,k) + w(i,j+1,k)) / 2., v(i,j,k), v(i,j,k+1))
+                          - flux((w(i,j,k-1) + w(i,j+1,k-1)) / 2., v(i,j,k-1), v(i,j,k))) * invDz;
+      g(i,j,k) = v(i,j,k) + deltaT*(laplacian*invRe - DuvDx - Dv2Dy - DvwDz + settings_.g[1]);
     }
+  };
+
+  // h on the w points [iBegin, iEnd) of a row
+  auto hRow = [&](int j, int k, int iBegin, int iEnd)
+  {
+    #pragma omp simd
+    for(int i = iBegin; i < iEnd; i++)
+    {
+      const double laplacian = (w(i+1,j,k) - 2*w(i,j,k) + w(i-1,j,k)) * invDx2
+                             + (w(i,j+1,k) - 2*w(i,j,k) + w(i,j-1,k)) * invDy2
+                             + (w(i,j,k+1) - 2*w(i,j,k) + w(i,j,k-1)) * invDz2;
+      const double DuwDx = (flux((u(i,j,k) + u(i,j,k+1)) / 2., w(i,j,k), w(i+1,j,k))
+                          - flux((u(i-1,j,k) + u(i-1,j,k+1)) / 2., w(i-1,j,k), w(i,j,k))) * invDx;
+      const double DvwDy = (flux((v(i,j,k) + v(i,j,k+1)) / 2., w(i,j,k), w(i,j+1,k))
+                          - flux((v(i,j-1,k) + v(i,j-1,k+1)) / 2., w(i,j-1,k), w(i,j,k))) * invDy;
+      const double Dw2Dz = (flux((w(i,j,k) + w(i,j,k+1)) / 2., w(i,j,k), w(i,j,k+1))
+                          - flux((w(i,j,k-1) + w(i,j,k)) / 2., w(i,j,k-1), w(i,j,k))) * invDz;
+      h(i,j,k) = w(i,j,k) + deltaT*(laplacian*invRe - DuwDx - DvwDy - Dw2Dz + settings_.g[2]);
+    }
+  };
+
+  if(!withRHS)
+  {
+    #pragma omp parallel for collapse(2)
+    for(int k = 0; k < ukN(); k++)
+      for(int j = 0; j < ujN(); j++)
+        forRowSegments(region, shellWidth_, j, k, uiN(), ujN(), ukN(), [&](int iBegin, int iEnd) { fRow(j, k, iBegin, iEnd); });
+    #pragma omp parallel for collapse(2)
+    for(int k = 0; k < vkN(); k++)
+      for(int j = 0; j < vjN(); j++)
+        forRowSegments(region, shellWidth_, j, k, viN(), vjN(), vkN(), [&](int iBegin, int iEnd) { gRow(j, k, iBegin, iEnd); });
+    #pragma omp parallel for collapse(2)
+    for(int k = 0; k < wkN(); k++)
+      for(int j = 0; j < wjN(); j++)
+        forRowSegments(region, shellWidth_, j, k, wiN(), wjN(), wkN(), [&](int iBegin, int iEnd) { hRow(j, k, iBegin, iEnd); });
+    return;
   }
 
-  // calculate h
-  #pragma omp simd collapse(3)
-  for(int k = 0; k < wkN(); k++)
+  // One pass over the planes: the rhs of plane k only needs f and g of the same plane and h of the plane below,
+  // so u, v, w, f, g and h of the last planes are still in cache and the fields are streamed once instead of twice.
+  // The rhs of the cells at the faces of the partition reads the boundary values of f, g and h, which are only
+  // set afterwards, so they are recalculated by calculateBoundaryRHS. The rhs of the interior reads the boundary values
+  // only at the Dirichlet faces, so after the shell it completes the interior of the fields.
+  const double invDeltaT = 1. / deltaT;
+  const int kN = std::max(ukN(), std::max(vkN(), wkN()));
+  #pragma omp parallel
+  for(int k = 0; k < kN; k++)
   {
-    for(int j = 0; j < wjN(); j++)
+    if(k < ukN())
+    {
+      #pragma omp for nowait
+      for(int j = 0; j < ujN(); j++)
+        forRowSegments(region, shellWidth_, j, k, uiN(), ujN(), ukN(), [&](int iBegin, int iEnd) { fRow(j, k, iBegin, iEnd); });
+    }
+    if(k < vkN())
+    {
+      #pragma omp for nowait
+      for(int j = 0; j < vjN(); j++)
+        forRowSegments(region, shellWidth_, j, k, viN(), vjN(), vkN(), [&](int iBegin, int iEnd) { gRow(j, k, iBegin, iEnd); });
+    }
+    if(k < wkN())
+    {
+      #pragma omp for nowait
+      for(int j = 0; j < wjN(); j++)
+        forRowSegments(region, shellWidth_, j, k, wiN(), wjN(), wkN(), [&](int iBegin, int iEnd) { hRow(j, k, iBegin, iEnd); });
+    }
+    // the rows of the rhs read g of the row below, which may have been calculated by another thread
+    #pragma omp barrier
+    if(k < pkN())
     {
-        for(int i = 0; i < wiN(); i++)
+      #pragma omp for nowait
+      for(int j = 0; j < pjN(); j++)
+        forRowSegments(region, shellWidth_, j, k, piN(), pjN(), pkN(), [&](int iBegin, int iEnd)
         {
-            const double D2wDx2 = computeD2wDx2(i,j,k);
-            const double D2wDy2 = computeD2wDy2(i,j,k);
-            const double D2wDz2 = computeD2wDz2(i,j,k);
-            const double DuwDx  = computeDuwDx (i,j,k);
-            const double DvwDy  = computeDvwDy (i,j,k);
-            const double Dw2Dz  = computeDw2Dz (i,j,k);
-            // h!!! instead of g and w instead of v
-            h(i,j,k) = w(i,j,k) + deltaT*((D2wDx2+D2wDy2+D2wDz2)/settings_.re
-              - DuwDx - DvwDy - Dw2Dz + settings_.g[2]);
-        }
+          rhsRow(rhs, f, g, h, j, k, iBegin, iEnd, invDx, invDy, invDz, invDeltaT);
+        });
     }
   }
-
 }
 
-void Discretization::calculateRHS(double deltaT)
+template void Discretization::calculateFGHKernel<CentralFlux>(double deltaT, const CentralFlux &flux, bool withRHS,
+                                                             GridRegion region);
+template void Discretization::calculateFGHKernel<DonorCellFlux>(double deltaT, const DonorCellFlux &flux, bool withRHS,
+                                                               GridRegion region);
+
+void Discretization::calculateRHS(double deltaT, GridRegion region)
 {
+  const double invDx = 1. / dx(), invDy = 1. / dy(), invDz = 1. / dz();
+  const double invDeltaT = 1. / deltaT;
+  const Array3DView f = fView(), g = gView(), h = hView(), rhs = rhsView();
   // using f and g, calculate rhs
-  #pragma omp simd collapse(3)
+  #pragma omp parallel for collapse(2)
   for(int k = 0; k < pkN(); k++)
   {
     for(int j = 0; j < pjN(); j++)
     {
-      for(int i = 0; i < piN(); i++)
+      forRowSegments(region, shellWidth_, j, k, piN(), pjN(), pkN(), [&](int iBegin, int iEnd)
       {
-        const double DfDx = (f(i,j,k) - f(i-1,j,  k))   / dx();
-        const double DgDy = (g(i,j,k) - g(i,  j-1,k))   / dy();
-        const double DhDz = (h(i,j,k) - h(i,  j,  k-1)) / dz();
-        rhs(i,j,k) = (DfDx + DgDy + DhDz) / deltaT;
-      }
+        rhsRow(rhs, f, g, h, j, k, iBegin, iEnd, invDx, invDy, invDz, invDeltaT);
+      });
     }
   }
 }
 
 //! calculate the final velocities using f, g and p
-void Discretization::calculateUVW(double deltaT)
+void Discretization::calculateUVW(double deltaT, GridRegion region)
 {
+  const double dtDx = deltaT / dx(), dtDy = deltaT / dy(), dtDz = deltaT / dz();
+  const Array3DView u = uView(), v = vView(), w = wView();
+  const Array3DView f = fView(), g = gView(), h = hView(), p = pView();
+  // the maxima of the new velocities are recorded for the next calculateVelocityDelta, which is cheaper
+  // than reading the fields again, as they are still in registers here, the interior adds to the ones of the shell
+  const bool continueMaxima = region == GridRegion::Interior;
+  double max_u = continueMaxima ? interiorVelocityMax_[0] : std::numeric_limits<double>::epsilon();
+  double max_v = continueMaxima ? interiorVelocityMax_[1] : std::numeric_limits<double>::epsilon();
+  double max_w = continueMaxima ? interiorVelocityMax_[2] : std::numeric_limits<double>::epsilon();
+
   // calculate u
-  #pragma omp simd collapse(3)
+  #pragma omp parallel for collapse(2) reduction(max:max_u)
   for(int k = 0; k < ukN(); k++)
   {
     for(int j = 0; j < ujN(); j++)
     {
-      for(int i = 0; i < uiN(); i++)
+      forRowSegments(region, shellWidth_, j, k, uiN(), ujN(), ukN(), [&](int iBegin, int iEnd)
       {
-        u(i,j,k) = f(i,j,k) - deltaT*computeDpDx(i,j,k);
-      }
+        #pragma omp simd reduction(max:max_u)
+        for(int i = iBegin; i < iEnd; i++)
+        {
+          const double u_new = f(i,j,k) - dtDx*(p(i+1,j,k) - p(i,j,k));
+          u(i,j,k) = u_new;
+          max_u = std::max(max_u, u_new);
+        }
+      });
     }
   }
 
   // calculate v
-  #pragma omp simd collapse(3)
+  #pragma omp parallel for collapse(2) reduction(max:max_v)
   for(int k = 0; k < vkN(); k++)
   {
     for(int j = 0; j < vjN(); j++)
     {
-      for(int i = 0; i < viN(); i++)
+      forRowSegments(region, shellWidth_, j, k, viN(), vjN(), vkN(), [&](int iBegin, int iEnd)
       {
-        v(i,j,k) = g(i,j,k) - deltaT*computeDpDy(i,j,k);
-      }
+        #pragma omp simd reduction(max:max_v)
+        for(int i = iBegin; i < iEnd; i++)
+        {
+          const double v_new = g(i,j,k) - dtDy*(p(i,j+1,k) - p(i,j,k));
+          v(i,j,k) = v_new;
+          max_v = std::max(max_v, v_new);
+        }
+      });
     }
   }
 
   // calculate w
-  #pragma omp simd collapse(3)
+  #pragma omp parallel for collapse(2) reduction(max:max_w)
   for(int k = 0; k < wkN(); k++)
   {
     for(int j = 0; j < wjN(); j++)
     {
-      for(int i = 0; i < wiN(); i++)
+      forRowSegments(region, shellWidth_, j, k, wiN(), wjN(), wkN(), [&](int iBegin, int iEnd)
       {
-        w(i,j,k) = h(i,j,k) - deltaT*computeDpDz(i,j,k);
-      }
+        #pragma omp simd reduction(max:max_w)
+        for(int i = iBegin; i < iEnd; i++)
+        {
+          const double w_new = h(i,j,k) - dtDz*(p(i,j,k+1) - p(i,j,k));
+          w(i,j,k) = w_new;
+          max_w = std::max(max_w, w_new);
+        }
+      });
     }
   }
+  interiorVelocityMax_ = {max_u, max_v, max_w};
+  // the maxima of the shell alone are incomplete
+  interiorVelocityMaxValid_ = region != GridRegion::Shell;
 }
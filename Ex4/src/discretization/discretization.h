@@ -2,8 +2,12 @@
 
 #include <array>
 #include <cassert>
+#include <limits>
+#include <algorithm>
 #include "discretization/partition_information.h"
 #include "discretization/staggered_grid.h"
+#include "discretization/convective_flux.h"
+#include "discretization/grid_region.h"
 #include "settings.h"
 
 class Discretization : public StaggeredGrid
@@ -12,20 +16,33 @@ public:
   //! construct the object with given number of cells in x and y direction
   Discretization(PartitionInformation &pi, const Settings &settings);
 
-  //! calculate the deltaT depending on the velocity and mesh-width, includes boundaries
+  //! calculate the deltaT depending on the velocity and mesh-width, includes boundaries,
+  //! with useFusedKernels only the ghost layers are read and the inner maxima of calculateUVW are reused
   double calculateVelocityDelta() const;
 
   //! calculate the deltaT depending on the reynolds constant and mesh-width
   double calculateReynoldsDelta() const;
 
-  //! calculate the preliminary velocities (f, g) and the rhs for pressure solver
-  void calculateFGH(double deltaT);
+  //! calculate the preliminary velocities (f, g, h) in the region, the schemes call calculateFGHKernel with their flux
+  virtual void calculateFGH(double deltaT, GridRegion region = GridRegion::All) = 0;
 
-  //! calculate the preliminary velocities (f, g) and the rhs for pressure solver
-  void calculateRHS(double deltaT);
+  //! calculateFGH and calculateRHS in one pass over the planes, the rhs of the cells at the faces of the partition
+  //! is only valid after setBoundaryFGH and calculateBoundaryRHS
+  virtual void calculateFGHAndRHS(double deltaT, GridRegion region = GridRegion::All) = 0;
 
-  //! calculate the final velocities using f, g and p
-  void calculateUVW(double deltaT);
+  //! recalculates the rhs of the first and last cells in each direction, which depend on the boundary values of f, g and h
+  void calculateBoundaryRHS(double deltaT) { calculateRHS(deltaT, GridRegion::Shell); }
+
+  //! calculate the rhs for pressure solver from f, g and h, the interior reads their boundary values only at the
+  //! Dirichlet faces
+  void calculateRHS(double deltaT, GridRegion region = GridRegion::All);
+
+  //! calculate the final velocities using f, g and p, records their maxima for calculateVelocityDelta,
+  //! the interior reads p only at the Dirichlet faces, the shell has to be calculated before it
+  void calculateUVW(double deltaT, GridRegion region = GridRegion::All);
+
+  //! the shell of the partition of the GridRegion of the kernels, it is the same for all fields
+  inline const ShellWidth &shellWidth() const { return shellWidth_; }
 
   //! return the meshwidth in x-direction
   inline double dx() const { return meshWidth_[0]; };
@@ -117,9 +134,24 @@ public:
   //! compute the 1st derivative ∂ (vw) / ∂z
   virtual double computeDvwDz(int i, int j, int k) const = 0;
 
+protected:
+  //! F, G and H with the convective terms of Flux inlined, so the rows compile into straight-line SIMD code
+  //! instead of nine virtual calls per cell, instantiated for CentralFlux and DonorCellFlux
+  //! withRHS also calculates the rhs in the same pass, see calculateFGHAndRHS
+  template<typename Flux>
+  void calculateFGHKernel(double deltaT, const Flux &flux, bool withRHS = false, GridRegion region = GridRegion::All);
+
 private:
+  //! the deltaT of the velocity maxima
+  double velocityDelta(double max_u, double max_v, double max_w) const;
+
   //! Settings used
   const Settings &settings_;
   //! mesh width squared used for second derivates, or more precise dx2()
   const std::array<double, 3> meshWidth2_;
+  //! the cells towards the neighbours
+  const ShellWidth shellWidth_;
+  //! maxima of u, v and w without the ghost layers, recorded by calculateUVW, the shell starts them
+  std::array<double, 3> interiorVelocityMax_;
+  bool interiorVelocityMaxValid_ = false;
 };
@@ -13,6 +13,16 @@ public:
             Discretization(pi, settings),
             alpha_(settings.alpha) { assert(alpha_ > 0); }
 
+  //! preliminary velocities with the donor cell flux inlined
+  void calculateFGH(double deltaT, GridRegion region = GridRegion::All) override
+  {
+    calculateFGHKernel(deltaT, DonorCellFlux{alpha_}, false, region);
+  }
+  void calculateFGHAndRHS(double deltaT, GridRegion region = GridRegion::All) override
+  {
+    calculateFGHKernel(deltaT, DonorCellFlux{alpha_}, true, region);
+  }
+
   double computeDuvDx(int i, int j, int k) const override;
   double computeDuvDy(int i, int j, int k) const override;
 
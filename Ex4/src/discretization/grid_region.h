@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+
+//! Cells of a field a kernel works on. The shell are the first and last cells towards the neighbours, which are sent
+//! to them and which read their ghost layers, the interior is the rest of the partition and only reads its own cells
+//! and the Dirichlet ghost layers. So a kernel can calculate the shell, send it and calculate the interior, while the
+//! halos are in flight.
+enum class GridRegion : char
+{
+  All,
+  Shell,
+  Interior
+};
+
+//! width of the shell at the lower and upper face in each direction, 1 towards a neighbour and 0 at a Dirichlet
+//! boundary, whose ghost layer is set, before the interior is calculated
+struct ShellWidth
+{
+  std::array<int, 3> lower;
+  std::array<int, 3> upper;
+};
+
+//! calls row(iBegin, iEnd) for the parts of the row (j,k) in the region of a field with the cells [0, iN) x [0, jN) x [0, kN),
+//! the rows in the shell in y or z belong completely to it, the others only with their cells in the shell in x
+template<typename Row>
+inline void forRowSegments(GridRegion region, const ShellWidth &shell, int j, int k, int iN, int jN, int kN, const Row &row)
+{
+  if(region == GridRegion::All)
+  {
+    row(0, iN);
+    return;
+  }
+  const int iBegin = shell.lower[0], iEnd = std::max(iBegin, iN - shell.upper[0]);
+  const bool interiorRow = j >= shell.lower[1] && j < jN - shell.upper[1] && k >= shell.lower[2] && k < kN - shell.upper[2];
+  if(region == GridRegion::Interior)
+  {
+    if(interiorRow && iBegin < iEnd)
+      row(iBegin, iEnd);
+    return;
+  }
+  if(!interiorRow)
+  {
+    row(0, iN);
+    return;
+  }
+  if(iBegin > 0)
+    row(0, iBegin);
+  if(iEnd < iN)
+    row(iEnd, iN);
+}
@@ -1,9 +1,49 @@
 #include "discretization/partition_information.h"
 
+PartitionInformation::PartitionInformation(std::array<int, 3> nCellsGlobal, std::array<double, 3> meshWidth,
+                                           MPI_Comm comm) :
+                                           PartitionInformation(nCellsGlobal, meshWidth,
+                                                                createCartesianComm(nCellsGlobal, comm))
+{
+}
+
+PartitionInformation::PartitionInformation(std::array<int, 3> nCellsGlobal, std::array<double, 3> meshWidth,
+                                           std::shared_ptr<MPI_Comm> cartesianComm) :
+                                           rank_([&cartesianComm]() { int rank; MPI_Comm_rank(*cartesianComm, &rank); return rank; }()),
+                                           nRanks_([&cartesianComm]() { int size; MPI_Comm_size(*cartesianComm, &size); return size; }()),
+                                           comm_(cartesianComm),
+                                           nCellsGlobal_(nCellsGlobal),
+                                           meshWidth_(meshWidth),
+                                           totalNoOfCellsGlobal_(nCellsGlobal[0]*nCellsGlobal[1]*nCellsGlobal[2])
+{
+    // the dimensions are {z, y, x}
+    std::array<int, 3> dims, periods, coords;
+    MPI_Cart_get(*comm_, 3, dims.data(), periods.data(), coords.data());
+    partPosX_ = coords[2];
+    partPosY_ = coords[1];
+    partPosZ_ = coords[0];
+
+    // the neighbours beyond the domain are MPI_PROC_NULL, which is -1 here
+    const auto neighbours = [this](int dimension, int &lowerRank, int &upperRank)
+    {
+        MPI_Cart_shift(*comm_, dimension, 1, &lowerRank, &upperRank);
+        if(lowerRank == MPI_PROC_NULL)
+            lowerRank = -1;
+        if(upperRank == MPI_PROC_NULL)
+            upperRank = -1;
+    };
+    neighbours(2, leftRank_, rightRank_);
+    neighbours(1, bottomRank_, topRank_);
+    neighbours(0, hindRank_, frontRank_);
+
+    sliceDomain({dims[2], dims[1], dims[0]});
+}
+
 PartitionInformation::PartitionInformation(std::array<int, 3> nCellsGlobal,
                                            std::array<double, 3> meshWidth, 
                                            int rank, int nRanks) :
                                            rank_(rank), nRanks_(nRanks),
+                                           comm_(sharedComm(MPI_COMM_WORLD)),
                                            nCellsGlobal_(nCellsGlobal),
                                            meshWidth_(meshWidth),
                                            totalNoOfCellsGlobal_(nCellsGlobal[0]*nCellsGlobal[1]*nCellsGlobal[2])
@@ -11,6 +51,33 @@ PartitionInformation::PartitionInformation(std::array<int, 3> nCellsGlobal,
     assert(rank < nRanks);
     assert(rank >= 0);
 
+    const std::array<int, 3> nPart = bestPartitioning(nCellsGlobal, nRanks, rank == 0);
+    const int nPartX = nPart[0];
+    const int nPartY = nPart[1];
+    const int nPartZ = nPart[2];
+
+    partPosX_ = rank_ % nPartX;
+    partPosY_ = (rank_ / nPartX) % nPartY;
+    partPosZ_ = rank_ / (nPartX*nPartY);
+
+    if(partPosX_ > 0)        // not the left-most partition
+        leftRank_  = rank_ - 1;
+    if(partPosX_ < nPartX-1) // not the right-most partition
+        rightRank_  = rank_ + 1;
+    if(partPosY_ > 0)
+        bottomRank_ = rank_ - nPartX;   // one line down
+    if(partPosY_ < nPartY-1)
+        topRank_ = rank_ + nPartX;
+    if(partPosZ_ > 0)
+        hindRank_ = rank_ - nPartX*nPartY;
+    if(partPosZ_ < nPartZ-1)
+        frontRank_ = rank_ + nPartX*nPartY;
+
+    sliceDomain(nPart);
+}
+
+std::array<int, 3> PartitionInformation::bestPartitioning(const std::array<int, 3> &nCellsGlobal, int nRanks, bool print)
+{
     //calculate possible partitions
     std::vector<std::array<int, 3>> partitionings = {};  //stores partitionings with format {x,y,z} 
     for(int x=1; x<=nRanks; x++) {
@@ -36,57 +103,65 @@ PartitionInformation::PartitionInformation(std::array<int, 3> nCellsGlobal,
         }
     }
     
-    if(rank == 0)
+    if(print)
     {
         std::cout << "Best partitioning scheme: " << bestPartitioning[0] << ", " << bestPartitioning[1] << ", " << bestPartitioning[2] 
             << " with surface: " << partitioningSurface << std::endl;
     }
 
-    int nPartX = bestPartitioning[0];
-    int nPartY = bestPartitioning[1];
-    int nPartZ = bestPartitioning[2];
-
-    if(nRanks != nPartX*nPartY*nPartZ)
+    if(nRanks != bestPartitioning[0]*bestPartitioning[1]*bestPartitioning[2])
     {
         std::stringstream str;
         str << "The found partition scheme for " << nRanks << " was " 
-            << nPartX << 'x' << nPartY << 'x' << nPartZ << " which does not multiply to nRanks.\n";
+            << bestPartitioning[0] << 'x' << bestPartitioning[1] << 'x' << bestPartitioning[2]
+            << " which does not multiply to nRanks.\n";
         throw std::runtime_error(str.str());
     }
+    return bestPartitioning;
+}
 
-    partPosX_ = rank_ % nPartX;
-    partPosY_ = (rank_ / nPartX) % nPartY;
-    partPosZ_ = rank_ / (nPartX*nPartY);
+std::shared_ptr<MPI_Comm> PartitionInformation::createCartesianComm(const std::array<int, 3> &nCellsGlobal, MPI_Comm comm)
+{
+    int rank, nRanks;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &nRanks);
+    const std::array<int, 3> nPart = bestPartitioning(nCellsGlobal, nRanks, rank == 0);
 
-    if(partPosX_ > 0)        // not the left-most partition
-    {
-        // so set the rank information and add an additional ghost layer
-        leftRank_  = rank_ - 1;
-    }
-    if(partPosX_ < nPartX-1) // not the right-most partition
+    // the last dimension is the fastest one of the row-major rank order of MPI
+    const std::array<int, 3> dims{nPart[2], nPart[1], nPart[0]};
+    const std::array<int, 3> periods{0, 0, 0};
+    MPI_Comm cartesianComm;
+    MPI_Cart_create(comm, 3, dims.data(), periods.data(), 1, &cartesianComm);
+    return sharedComm(cartesianComm);
+}
+
+std::shared_ptr<MPI_Comm> PartitionInformation::sharedComm(MPI_Comm comm)
+{
+    return std::shared_ptr<MPI_Comm>(new MPI_Comm(comm), [](MPI_Comm *comm)
     {
-        rightRank_  = rank_ + 1;
+        // the partition information may outlive MPI_Finalize, which frees the communicators anyway
+        int finalized;
+        MPI_Finalized(&finalized);
+        if(!finalized && *comm != MPI_COMM_WORLD)
+            MPI_Comm_free(comm);
+        delete comm;
+    });
+}
+
+void PartitionInformation::sliceDomain(const std::array<int, 3> &nPart)
+{
+    const int nPartX = nPart[0];
+    const int nPartY = nPart[1];
+    const int nPartZ = nPart[2];
+
+    // the partitions with a neighbour on the upper side have an additional ghost layer for the velocity
+    if(rightRank_ != -1)
         uGhostLayer_ = 1;
-    }
-    if(partPosY_ > 0)
-    {
-        bottomRank_ = rank_ - nPartX;   // one line down
-    }
-    if(partPosY_ < nPartY-1)
-    {
-        topRank_ = rank_ + nPartX;
+    if(topRank_ != -1)
         vGhostLayer_ = 1;
-    }
-    if(partPosZ_ > 0)
-    {
-        hindRank_ = rank_ - nPartX*nPartY;
-    }
-    if(partPosZ_ < nPartZ-1)
-    {
-        frontRank_ = rank_ + nPartX*nPartY;
+    if(frontRank_ != -1)
         wGhostLayer_ = 1;
-    }
-    
+
     // slice the whole domain into chunks
     double cellsPerPartitionX = (double)nCellsGlobal_[0] / (double)nPartX;
     double cellsPerPartitionY = (double)nCellsGlobal_[1] / (double)nPartY;
@@ -104,19 +179,19 @@ PartitionInformation::PartitionInformation(std::array<int, 3> nCellsGlobal,
     int zPrevEnd = std::ceil(cellsPerPartitionZ * (partPosZ_ - 1)) + zCells;
     if(partPosX_ > 0 && xPrevEnd > nodeOffset_[0])
     {
-        std::cout << "R:" << rank << " overlap on left boundary corrected\n";
+        std::cout << "R:" << rank_ << " overlap on left boundary corrected\n";
         nodeOffset_[0]++;
         xCells--;
     }
     if(partPosY_ > 0 && yPrevEnd > nodeOffset_[1])
     {
-        std::cout << "R:" << rank << " overlap on bottom boundary corrected\n";
+        std::cout << "R:" << rank_ << " overlap on bottom boundary corrected\n";
         nodeOffset_[1]++;
         yCells--;
     }
     if(partPosZ_ > 0 && zPrevEnd > nodeOffset_[2])
     {
-        std::cout << "R:" << rank << " overlap on hind boundary corrected\n";
+        std::cout << "R:" << rank_ << " overlap on hind boundary corrected\n";
         nodeOffset_[2]++;
         zCells--;
     }
@@ -137,8 +212,8 @@ PartitionInformation::PartitionInformation(std::array<int, 3> nCellsGlobal,
     if(!ownPartitionContainsRightBoundary())
         neighbourEdgeCells += nCellsLocal_[1];
     int allNeighbourCells;
-    MPI_Allreduce(&neighbourEdgeCells, &allNeighbourCells, 1, MPI_INT32_T, MPI_SUM, MPI_COMM_WORLD);
-    if(rank == 0)
+    MPI_Allreduce(&neighbourEdgeCells, &allNeighbourCells, 1, MPI_INT32_T, MPI_SUM, *comm_);
+    if(rank_ == 0)
     {
 
 	    double area = nCellsLocal_[0] * nCellsLocal_[1];
@@ -156,3 +231,69 @@ PartitionInformation::PartitionInformation(std::array<int, 3> nCellsGlobal,
         << nodeOffset_[0] << ", " << nodeOffset_[0]+nCellsLocal_[0]-1
         << "]x[" << nodeOffset_[1] << ", " << nodeOffset_[1]+nCellsLocal_[1]-1 << "]x[" << nodeOffset_[2] << ", " << nodeOffset_[2]+nCellsLocal_[2]-1 << "]\n";
 }
+
+
+PartitionInformation::PartitionInformation(const PartitionInformation &fine, int coarseningFactor) :
+                                           PartitionInformation(fine, coarsePartitionCells(fine, coarseningFactor))
+{
+}
+
+PartitionInformation::PartitionInformation(const PartitionInformation &fine, const std::array<std::vector<int>, 3> &coarseCells) :
+                                           rank_(fine.rank_), nRanks_(fine.nRanks_), comm_(fine.comm_),
+                                           nCellsGlobal_({std::accumulate(coarseCells[0].begin(), coarseCells[0].end(), 0),
+                                                          std::accumulate(coarseCells[1].begin(), coarseCells[1].end(), 0),
+                                                          std::accumulate(coarseCells[2].begin(), coarseCells[2].end(), 0)}),
+                                           // the physical size stays the same, which is the mean width of uneven coarse cells
+                                           meshWidth_({fine.meshWidth_[0] * fine.nCellsGlobal_[0] / nCellsGlobal_[0],
+                                                       fine.meshWidth_[1] * fine.nCellsGlobal_[1] / nCellsGlobal_[1],
+                                                       fine.meshWidth_[2] * fine.nCellsGlobal_[2] / nCellsGlobal_[2]}),
+                                           totalNoOfCellsGlobal_(nCellsGlobal_[0]*nCellsGlobal_[1]*nCellsGlobal_[2]),
+                                           bottomRank_(fine.bottomRank_), topRank_(fine.topRank_),
+                                           leftRank_(fine.leftRank_), rightRank_(fine.rightRank_),
+                                           frontRank_(fine.frontRank_), hindRank_(fine.hindRank_),
+                                           uGhostLayer_(fine.uGhostLayer_), vGhostLayer_(fine.vGhostLayer_),
+                                           wGhostLayer_(fine.wGhostLayer_),
+                                           partPosX_(fine.partPosX_), partPosY_(fine.partPosY_), partPosZ_(fine.partPosZ_)
+{
+    const std::array<int, 3> partPos{partPosX_, partPosY_, partPosZ_};
+    for(int d = 0; d < 3; d++)
+    {
+        nCellsLocal_[d] = coarseCells[d][partPos[d]];
+        nodeOffset_[d]  = std::accumulate(coarseCells[d].begin(), coarseCells[d].begin() + partPos[d], 0);
+    }
+}
+
+std::array<std::vector<int>, 3> PartitionInformation::coarsePartitionCells(const PartitionInformation &fine, int coarseningFactor)
+{
+    assert(coarseningFactor > 0);
+    std::array<int, 6> own;
+    for(int d = 0; d < 3; d++)
+    {
+        if(fine.nCellsLocal_[d] < 1)
+        {
+            std::stringstream str;
+            str << "R:" << fine.rank_ << " empty partition can not be coarsened in dimension " << d << "\n";
+            throw std::runtime_error(str.str());
+        }
+        own[d] = (fine.nCellsLocal_[d] + coarseningFactor - 1) / coarseningFactor;
+    }
+    own[3] = fine.partPosX_;
+    own[4] = fine.partPosY_;
+    own[5] = fine.partPosZ_;
+
+    // all partitions in the same slice along a direction have the same cell count in it
+    std::vector<int> all(6 * fine.nRanks_);
+    MPI_Allgather(own.data(), 6, MPI_INT, all.data(), 6, MPI_INT, fine.comm());
+    std::array<std::vector<int>, 3> coarseCells;
+    for(int r = 0; r < fine.nRanks_; r++)
+    {
+        for(int d = 0; d < 3; d++)
+        {
+            const int position = all[6*r + 3 + d];
+            if(position >= (int)coarseCells[d].size())
+                coarseCells[d].resize(position + 1, 0);
+            coarseCells[d][position] = all[6*r + d];
+        }
+    }
+    return coarseCells;
+}
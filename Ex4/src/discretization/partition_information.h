@@ -1,20 +1,36 @@
 #pragma once
 
 #include <array>
+#include <algorithm>
+#include <numeric>
 #include <vector>
 #include <cassert>
 #include <exception>
 #include <sstream>
 #include <cmath>
 #include <iostream>
+#include <memory>
 #include <mpi.h>
 
 //! this primarily serves the purpose of a data object calculating all relevant data
 class PartitionInformation
 {
 public:
+    //! Decomposes the domain on all ranks of comm, collective. The partitions are the grid of a Cartesian communicator,
+    //! which is created with reorder, so the MPI library may renumber the ranks to place neighbouring partitions on
+    //! the same node. The own rank and the ranks of the neighbours are the ones of comm(), not of comm.
+    PartitionInformation(std::array<int, 3> nCellsGlobal, std::array<double, 3> meshWidth, MPI_Comm comm);
+
+    //! the partition of rank in a decomposition on nRanks ranks without creating a communicator, the ranks are
+    //! numbered like the Cartesian communicator without reordering and comm() is MPI_COMM_WORLD, used by the tests
     PartitionInformation(std::array<int, 3> nCellsGlobal, 
                          std::array<double, 3> meshWidth, int rank, int nRanks);
+
+    //! constructs the information of a coarser grid level on the same ranks and neighbours,
+    //! used by the multigrid solver. Each partition is coarsened on its own, so the coarse cells align with
+    //! the partition borders, a local cell count, which is not divisible, leaves a smaller last coarse cell.
+    //! Collective, as the offsets depend on the coarse cell counts of the other partitions.
+    PartitionInformation(const PartitionInformation &fine, int coarseningFactor);
     //! get the local number of cells in the own subdomain
     inline std::array<int, 3> nCellsLocal()  const { return nCellsLocal_; }
 
@@ -36,6 +52,10 @@ public:
     //! number of MPI ranks
     inline int nRanks() const { return nRanks_; }
 
+    //! communicator of the partitions, the point-to-point messages to the neighbours and the collectives, which
+    //! depend on the rank numbers, use it. The coarse levels share it with the fine one.
+    inline MPI_Comm comm() const { return *comm_; }
+
     //! if the own partition has part of the bottom boundary of the whole domain
     inline bool ownBottomBoundary() const { return bottomRank_  == -1; }
     inline bool ownTopBoundary()    const { return topRank_     == -1; }
@@ -64,15 +84,41 @@ public:
     inline int uGhostLayer() const { return uGhostLayer_; }
     inline int vGhostLayer() const { return vGhostLayer_; }
     inline int wGhostLayer() const { return wGhostLayer_; }
+    //! the deepest halo of a cell field, which can be filled by the direct neighbours only,
+    //! the neighbours have (nearly) the same size, so the own one is used
+    inline int maximumHaloDepth() const { return std::min(nCellsLocal_[0], std::min(nCellsLocal_[1], nCellsLocal_[2])); }
+
     //! Get the partition coordinates
     inline int getPartPosX() const { return partPosX_; }
     inline int getPartPosY() const { return partPosY_; }
     inline int getPartPosZ() const { return partPosZ_; }
 
 private:
+    //! the partitioning with the smallest surface between the partitions, which is {nPartX, nPartY, nPartZ}
+    static std::array<int, 3> bestPartitioning(const std::array<int, 3> &nCellsGlobal, int nRanks, bool print);
+
+    //! Cartesian communicator with the best partitioning on the ranks of comm, x is the fastest dimension,
+    //! so the ranks are numbered like before without reordering
+    static std::shared_ptr<MPI_Comm> createCartesianComm(const std::array<int, 3> &nCellsGlobal, MPI_Comm comm);
+
+    //! the communicator is freed with the last partition information using it, MPI_COMM_WORLD is not freed
+    static std::shared_ptr<MPI_Comm> sharedComm(MPI_Comm comm);
+
+    PartitionInformation(std::array<int, 3> nCellsGlobal, std::array<double, 3> meshWidth,
+                         std::shared_ptr<MPI_Comm> cartesianComm);
+
+    //! sets the ghost layers and the cells and offset of the partition from its position and the neighbours
+    void sliceDomain(const std::array<int, 3> &nPart);
+
+    //! coarse cell counts of all partitions along each direction, indexed by the partition position
+    static std::array<std::vector<int>, 3> coarsePartitionCells(const PartitionInformation &fine, int coarseningFactor);
+
+    PartitionInformation(const PartitionInformation &fine, const std::array<std::vector<int>, 3> &coarseCells);
+
     //! rank information
     const int rank_;
     const int nRanks_;
+    std::shared_ptr<MPI_Comm> comm_;
 
     //! dimension information
     const std::array<int, 3> nCellsGlobal_;
@@ -9,6 +9,7 @@
 #include "discretization/partition_information.h"
 #include "boundary/boundary.h"
 #include "boundary/dirichlet.h"
+#include "storage/float_array3D.h"
 
 //! Class to encapsulate the discretization and its boundaries
 class PartitionShell
@@ -24,17 +25,51 @@ public:
     virtual void setBoundaryP() = 0;
     //! only exchange the pressure values with the respective neighbours w/o setting dirichlet
     virtual void exchangeP() = 0;
+    //! same as setBoundaryP and exchangeP, but for any field with the same layout as p
+    virtual void setBoundaryCellField(FieldVariable &field) = 0;
+    virtual void exchangeCellField(FieldVariable &field) = 0;
+    //! same for single precision fields, the halos are sent as float
+    virtual void setBoundaryCellField(FloatArray3D &field) = 0;
+    virtual void exchangeCellField(FloatArray3D &field) = 0;
+    //! exchanges the depth ghost layers of a deep halo cell field with the neighbours, one direction after the other
+    virtual void exchangeDeepCellField(Array3D &field, int depth) = 0;
     //! used before paraview output
     virtual void exchangeUVW() = 0;
 
+    //! The exchanges above split in two, so the communication overlaps with the calculation of the interior.
+    //! start sends the faces, which have to be calculated before, and sets the Dirichlet boundaries of the
+    //! setBoundary variants, finish sets the received ghost layers. Only one split exchange may be pending at a time.
+    virtual void startBoundaryFGH() = 0;
+    virtual void finishBoundaryFGH() = 0;
+    virtual void startBoundaryCellField(FieldVariable &field) = 0;
+    virtual void finishBoundaryCellField(FieldVariable &field) = 0;
+    virtual void startExchangeCellField(FieldVariable &field) = 0;
+    virtual void finishExchangeCellField(FieldVariable &field) = 0;
+    virtual void startExchangeUVW() = 0;
+    virtual void finishExchangeUVW() = 0;
+
     //! getter for the discretization, to make access in pressure-solver simpler
     inline std::shared_ptr<Discretization> getDiscretization() const { return discretization_; };
 
     //! wrapper for the relevant public discretization methods
     inline double calculateVelocityDelta() const { return discretization_->calculateVelocityDelta(); }
-    inline void calculateFGH(double deltaT) const { discretization_->calculateFGH(deltaT); }
-    inline void calculateRHS(double deltaT) const { discretization_->calculateRHS(deltaT); }
-    inline void calculateUVW(double deltaT) const { discretization_->calculateUVW(deltaT); }
+    inline void calculateFGH(double deltaT, GridRegion region = GridRegion::All) const
+    {
+        discretization_->calculateFGH(deltaT, region);
+    }
+    inline void calculateRHS(double deltaT, GridRegion region = GridRegion::All) const
+    {
+        discretization_->calculateRHS(deltaT, region);
+    }
+    inline void calculateFGHAndRHS(double deltaT, GridRegion region = GridRegion::All) const
+    {
+        discretization_->calculateFGHAndRHS(deltaT, region);
+    }
+    inline void calculateBoundaryRHS(double deltaT) const { discretization_->calculateBoundaryRHS(deltaT); }
+    inline void calculateUVW(double deltaT, GridRegion region = GridRegion::All) const
+    {
+        discretization_->calculateUVW(deltaT, region);
+    }
     inline double calculateReynoldsDelta() const { return discretization_->calculateReynoldsDelta(); }
 
     inline void fixDirichletBoundary()
@@ -43,12 +78,22 @@ public:
             fixBoundary->setUVW();
     }
 
+    //! sets the Neumann ghost layer of a deep halo cell field, it only requires local data
+    inline void setDirichletDeepCellField(Array3D &field, int depth)
+    {
+        for(std::shared_ptr<Dirichlet> fixBoundary : fixBoundaries_)
+            fixBoundary->setDeepCellField(field, depth);
+    }
+
     //! information relevant to the partition
     const PartitionInformation &pi_;
 
     #ifdef TIMER
     //! neighbour communication timer
     Timekeeper timer_;
+    //! parts of timer_ spent waiting for the faces of the neighbours and unpacking them
+    Timekeeper idleTimer_;
+    Timekeeper unpackTimer_;
     #endif
 
 protected:
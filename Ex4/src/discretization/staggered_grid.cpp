@@ -81,4 +81,51 @@ StaggeredGrid::StaggeredGrid(PartitionInformation &pi)
       vi0_(1), vj0_(1), vk0_(1),
       wi0_(1), wj0_(1), wk0_(1),
       pi0_(1), pj0_(1), pk0_(1),
-      uGhost_(pi.uGhostLayer()), vGhost_(pi.vGhostLayer()), wGhost_(pi.wGhostLayer()) {}
\ No newline at end of file
+      uGhost_(pi.uGhostLayer()), vGhost_(pi.vGhostLayer()), wGhost_(pi.wGhostLayer()) {}
+
+void StaggeredGrid::makeCGFields()
+{
+   //! this function may only be called once
+   if(cgFieldsMade_)
+      throw std::runtime_error("makeCGFields may only be called once\n");
+
+   cgFieldsMade_ = true;
+   r_ = std::make_shared<FieldVariable>(p_.size(), p_.getOrigin(), meshWidth_, "r");
+   z_ = std::make_shared<FieldVariable>(p_.size(), p_.getOrigin(), meshWidth_, "z");
+   a_ = std::make_shared<FieldVariable>(p_.size(), p_.getOrigin(), meshWidth_, "a");
+   q_ = std::make_shared<FieldVariable>(p_.size(), p_.getOrigin(), meshWidth_, "q");
+}
+
+void StaggeredGrid::makePipelinedCGFields()
+{
+   if(!cgFieldsMade_ || pipelinedCGFieldsMade_)
+      throw std::runtime_error("makePipelinedCGFields may only be called once after makeCGFields\n");
+
+   pipelinedCGFieldsMade_ = true;
+   az_ = std::make_shared<FieldVariable>(p_.size(), p_.getOrigin(), meshWidth_, "az");
+   maz_ = std::make_shared<FieldVariable>(p_.size(), p_.getOrigin(), meshWidth_, "maz");
+   amaz_ = std::make_shared<FieldVariable>(p_.size(), p_.getOrigin(), meshWidth_, "amaz");
+   mq_ = std::make_shared<FieldVariable>(p_.size(), p_.getOrigin(), meshWidth_, "mq");
+   amq_ = std::make_shared<FieldVariable>(p_.size(), p_.getOrigin(), meshWidth_, "amq");
+}
+
+void StaggeredGrid::makeDeepHaloP(int depth)
+{
+   if(deepP_ != nullptr)
+      throw std::runtime_error("makeDeepHaloP may only be called once\n");
+   if(depth < 1 || depth > std::min(nCells_[0], std::min(nCells_[1], nCells_[2])))
+   {
+      std::stringstream str;
+      str << "The halo depth " << depth << " has to be between 1 and the smallest local cell count of " 
+          << nCells_[0] << " x " << nCells_[1] << " x " << nCells_[2] << "!\n";
+      throw std::out_of_range(str.str());
+   }
+
+   haloDepth_ = depth;
+   const std::array<int, 3> size{nCells_[0] + 2*depth, nCells_[1] + 2*depth, nCells_[2] + 2*depth};
+   const std::array<double, 3> origin{p_.getOrigin()[0] - (depth-1) * meshWidth_[0],
+                                      p_.getOrigin()[1] - (depth-1) * meshWidth_[1],
+                                      p_.getOrigin()[2] - (depth-1) * meshWidth_[2]};
+   deepP_ = std::make_shared<FieldVariable>(size, origin, meshWidth_, "deepP");
+   deepRhs_ = std::make_shared<FieldVariable>(size, origin, meshWidth_, "deepRhs");
+}
\ No newline at end of file
@@ -2,6 +2,10 @@
 
 #include <array>
 #include <memory>
+#include <cassert>
+#include <exception>
+#include <sstream>
+#include <algorithm>
 #include "discretization/partition_information.h"
 #include "storage/field_variable.h"
 #include "settings.h"
@@ -11,6 +15,16 @@ public:
   //! constructor using the partition information (which includes info about boundaries)
   StaggeredGrid(PartitionInformation &pi);
 
+  //! allocates the work vectors of the Krylov solvers, may only be called once
+  void makeCGFields();
+
+  //! allocates the additional recurrence vectors of the pipelined CG, may only be called once after makeCGFields
+  void makePipelinedCGFields();
+
+  //! allocates copies of p and rhs with depth ghost layers on each side, which allow several sweeps between two exchanges,
+  //! may only be called once
+  void makeDeepHaloP(int depth);
+
   // cell width and number
   inline const std::array<double, 3> meshWidth() const { return meshWidth_; }
   inline const std::array<int, 3> nCells() const { return nCells_; }
@@ -25,6 +39,21 @@ public:
   inline FieldVariable &g() { return g_; }
   inline FieldVariable &h() { return h_; }
   inline FieldVariable &rhs() { return rhs_; }
+  // CG solver variables, only valid after makeCGFields
+  inline FieldVariable &r() { assert(cgFieldsMade_); return *r_; }
+  inline FieldVariable &z() { assert(cgFieldsMade_); return *z_; }
+  inline FieldVariable &a() { assert(cgFieldsMade_); return *a_; }
+  inline FieldVariable &q() { assert(cgFieldsMade_); return *q_; }
+  // pipelined CG variables, only valid after makePipelinedCGFields
+  inline FieldVariable &az() { assert(pipelinedCGFieldsMade_); return *az_; }
+  inline FieldVariable &maz() { assert(pipelinedCGFieldsMade_); return *maz_; }
+  inline FieldVariable &amaz() { assert(pipelinedCGFieldsMade_); return *amaz_; }
+  inline FieldVariable &mq() { assert(pipelinedCGFieldsMade_); return *mq_; }
+  inline FieldVariable &amq() { assert(pipelinedCGFieldsMade_); return *amq_; }
+  // deep halo pressure and rhs, only valid after makeDeepHaloP, the partition starts at haloDepth in each direction
+  inline FieldVariable &deepP() { assert(deepP_ != nullptr); return *deepP_; }
+  inline FieldVariable &deepRhs() { assert(deepRhs_ != nullptr); return *deepRhs_; }
+  inline int haloDepth() const { return haloDepth_; }
 
   // begin of each field, necassary for possible ghost layer
   inline int ui0() const { return ui0_; }
@@ -70,12 +99,47 @@ public:
   inline double &h(int i, int j, int k)       { return h_(i+wi0_,j+wj0_,k+wk0_); }
   inline double  rhs(int i, int j, int k) const { return rhs_(i,j,k); }
   inline double &rhs(int i, int j, int k)       { return rhs_(i,j,k); }
+  // CG solver variables use same indexing schema as p
+  inline double  r(int i, int j, int k) const { return (*r_)(i+pi0_,j+pj0_,k+pk0_); }
+  inline double &r(int i, int j, int k)       { return (*r_)(i+pi0_,j+pj0_,k+pk0_); }
+  inline double  z(int i, int j, int k) const { return (*z_)(i+pi0_,j+pj0_,k+pk0_); }
+  inline double &z(int i, int j, int k)       { return (*z_)(i+pi0_,j+pj0_,k+pk0_); }
+  inline double  a(int i, int j, int k) const { return (*a_)(i+pi0_,j+pj0_,k+pk0_); }
+  inline double &a(int i, int j, int k)       { return (*a_)(i+pi0_,j+pj0_,k+pk0_); }
+  inline double  q(int i, int j, int k) const { return (*q_)(i+pi0_,j+pj0_,k+pk0_); }
+  inline double &q(int i, int j, int k)       { return (*q_)(i+pi0_,j+pj0_,k+pk0_); }
+
+  // views for the kernels with the field begin offsets folded in, view(i,j,k) is the same value as the accessors above
+  inline Array3DView uView() { return u_.view(ui0_, uj0_, uk0_); }
+  inline Array3DView vView() { return v_.view(vi0_, vj0_, vk0_); }
+  inline Array3DView wView() { return w_.view(wi0_, wj0_, wk0_); }
+  inline Array3DView pView() { return p_.view(pi0_, pj0_, pk0_); }
+  inline Array3DView fView() { return f_.view(ui0_, uj0_, uk0_); }
+  inline Array3DView gView() { return g_.view(vi0_, vj0_, vk0_); }
+  inline Array3DView hView() { return h_.view(wi0_, wj0_, wk0_); }
+  inline Array3DView rhsView() { return rhs_.view(); }
+  inline ConstArray3DView uView() const { return u_.view(ui0_, uj0_, uk0_); }
+  inline ConstArray3DView vView() const { return v_.view(vi0_, vj0_, vk0_); }
+  inline ConstArray3DView wView() const { return w_.view(wi0_, wj0_, wk0_); }
+  inline ConstArray3DView pView() const { return p_.view(pi0_, pj0_, pk0_); }
+  inline ConstArray3DView rhsView() const { return rhs_.view(); }
+  //! any cell field with the layout of p, e.g. the CG fields
+  inline Array3DView cellView(FieldVariable &field) const { assert(field.size() == p_.size()); return field.view(pi0_, pj0_, pk0_); }
 
 protected:
   //! normal fluid-sim variables
   std::array<double, 3> meshWidth_;
   std::array<int, 3> nCells_;
   FieldVariable u_, v_, w_, p_, rhs_, f_, g_, h_;
+  //! CG solver variables, only defined when using said CG, same indexing as p
+  //! r: residuum, z: preconditioned residuum, a: search direction, q: stencil applied on a
+  std::shared_ptr<FieldVariable> r_, z_, a_, q_;
+  //! pipelined CG variables, named after the operators applied, A: stencil, M: preconditioner solve
+  //! az: A*z, maz: M^-1*A*z, amaz: A*M^-1*A*z, mq: M^-1*q, amq: A*M^-1*q
+  std::shared_ptr<FieldVariable> az_, maz_, amaz_, mq_, amq_;
+  //! p and rhs with haloDepth_ ghost layers
+  std::shared_ptr<FieldVariable> deepP_, deepRhs_;
+  int haloDepth_ = 1;
 
 private:
   // field begin offsets
@@ -95,4 +159,7 @@ private:
   const int uGhost_;
   const int vGhost_;
   const int wGhost_;
+
+  bool cgFieldsMade_ = false;
+  bool pipelinedCGFieldsMade_ = false;
 };
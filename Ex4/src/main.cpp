@@ -1,5 +1,8 @@
 #include <iostream>
 #include <mpi.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "settings.h"
 #include "computation.h"
 #include "timekeeper.h"
@@ -15,11 +18,16 @@
 // recommendation, for small number ranks (2 or 4) use normal mode 
 // and high number use async
 
+// the grid kernels are multithreaded, if configured with -DOPENMP=1,
+// the number of threads per rank is set with OMP_NUM_THREADS
+
 int main(int argc, char *argv[])
 {
   const auto t0 = timestamp();
 
-  MPI_Init(&argc, &argv);
+  // only the main thread communicates, the threads of the kernels never call MPI
+  int threadSupport;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &threadSupport);
 
   // Get the number of processes
   int world_size;
@@ -29,6 +37,13 @@ int main(int argc, char *argv[])
   int world_rank;
   MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
 
+  int nThreads = 1;
+  #ifdef _OPENMP
+  nThreads = omp_get_max_threads();
+  if(world_rank == 0 && threadSupport < MPI_THREAD_FUNNELED && nThreads > 1)
+    std::cerr << "The MPI library does not support MPI_THREAD_FUNNELED, the threads of the kernels may be unsafe\n";
+  #endif
+
   Settings settings;
   // one arg equals no arguments given
   if(argc <= 1)
@@ -59,7 +74,7 @@ int main(int argc, char *argv[])
   MPI_Finalize();
   // sim is, when it is, debug is printed only on one rank
   if(world_rank == 0)
-    std::cout << "\nSimulation with " << world_size << " ranks finished in " << std::setprecision(4) << getDurationS(t0) << "s\n\n";
+    std::cout << "\nSimulation with " << world_size << " ranks and " << nThreads << " threads per rank finished in " << std::setprecision(4) << getDurationS(t0) << "s\n\n";
   // For the timeout issues in parallel2, it was very likely caused by the fact,
   // that the partitioning scheme code was faulty.
     
@@ -0,0 +1,81 @@
+#include "pressure_solver/agglomerated_poisson.h"
+
+AgglomeratedPoisson::AgglomeratedPoisson(const PartitionInformation &pi, double dx2, double dy2, double dz2) :
+                                         comm_(pi.comm()), rank_(pi.ownRankNo()), nLocal_(pi.nCellsLocal()),
+                                         local_(pi.totalNoOfCellsLocal())
+{
+    const std::array<int, 3> offset = pi.nodeOffset();
+    const int box[6] = {offset[0], offset[1], offset[2], nLocal_[0], nLocal_[1], nLocal_[2]};
+    if(rank_ == 0)
+        boxes_.resize(6 * pi.nRanks());
+    MPI_Gather(box, 6, MPI_INT, boxes_.data(), 6, MPI_INT, 0, comm_);
+
+    if(rank_ != 0)
+        return;
+
+    const int nRanks = pi.nRanks();
+    counts_.resize(nRanks);
+    displacements_.resize(nRanks);
+    int total = 0;
+    for(int r = 0; r < nRanks; r++)
+    {
+        counts_[r] = boxes_[6*r+3] * boxes_[6*r+4] * boxes_[6*r+5];
+        displacements_[r] = total;
+        total += counts_[r];
+    }
+    gathered_.resize(total);
+
+    const std::array<int, 3> nGlobal = pi.nCellsGlobal();
+    const std::array<int, 3> withGhosts{nGlobal[0]+2, nGlobal[1]+2, nGlobal[2]+2};
+    const std::array<double, 3> meshWidth = pi.meshWidth();
+    const std::array<double, 3> origin{-meshWidth[0]/2., -meshWidth[1]/2., -meshWidth[2]/2.};
+    source_ = std::make_shared<FieldVariable>(withGhosts, origin, meshWidth, "agglomerated source");
+    solution_ = std::make_shared<FieldVariable>(withGhosts, origin, meshWidth, "agglomerated solution");
+    solver_ = std::make_shared<SubdomainPoisson>(nGlobal, dx2, dy2, dz2);
+}
+
+void AgglomeratedPoisson::solve(FieldVariable &rhs, FieldVariable &p)
+{
+    // the rhs starts at the first cell of the partition, p and the rank 0 fields at their ghost layer
+    const Array3DView b = rhs.view(), x = p.view(1, 1, 1);
+    int c = 0;
+    for(int k = 0; k < nLocal_[2]; k++)
+        for(int j = 0; j < nLocal_[1]; j++)
+            for(int i = 0; i < nLocal_[0]; i++)
+                local_[c++] = b(i,j,k);
+    MPI_Gatherv(local_.data(), local_.size(), MPI_DOUBLE, gathered_.data(), counts_.data(), displacements_.data(),
+                MPI_DOUBLE, 0, comm_);
+
+    if(rank_ == 0)
+    {
+        // SubdomainPoisson solves the negative laplacian, the partitions are placed with their ghost layer offset
+        const Array3DView source = source_->view(1, 1, 1), solution = solution_->view(1, 1, 1);
+        for(std::size_t r = 0; r < counts_.size(); r++)
+        {
+            const int *box = &boxes_[6*r];
+            const double *values = &gathered_[displacements_[r]];
+            for(int k = 0; k < box[5]; k++)
+                for(int j = 0; j < box[4]; j++)
+                    for(int i = 0; i < box[3]; i++)
+                        source(box[0]+i, box[1]+j, box[2]+k) = -*values++;
+        }
+        solver_->solve(*source_, *solution_);
+        for(std::size_t r = 0; r < counts_.size(); r++)
+        {
+            const int *box = &boxes_[6*r];
+            double *values = &gathered_[displacements_[r]];
+            for(int k = 0; k < box[5]; k++)
+                for(int j = 0; j < box[4]; j++)
+                    for(int i = 0; i < box[3]; i++)
+                        *values++ = solution(box[0]+i, box[1]+j, box[2]+k);
+        }
+    }
+
+    MPI_Scatterv(gathered_.data(), counts_.data(), displacements_.data(), MPI_DOUBLE,
+                 local_.data(), local_.size(), MPI_DOUBLE, 0, comm_);
+    c = 0;
+    for(int k = 0; k < nLocal_[2]; k++)
+        for(int j = 0; j < nLocal_[1]; j++)
+            for(int i = 0; i < nLocal_[0]; i++)
+                x(i,j,k) = local_[c++];
+}
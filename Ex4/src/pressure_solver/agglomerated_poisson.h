@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <mpi.h>
+#include "pressure_solver/subdomain_poisson.h"
+#include "discretization/partition_information.h"
+#include "storage/field_variable.h"
+
+//! Direct solver of a coarse multigrid level, which is agglomerated onto rank 0: the partitions are gathered,
+//! rank 0 solves the whole grid with the cosine transforms of SubdomainPoisson and the solution is scattered back.
+//! On the coarsest levels each rank only holds a few cells, so the sweeps there would be dominated by the
+//! latency of the halo exchanges, while the whole grid is still cheap to solve on one rank.
+class AgglomeratedPoisson
+{
+public:
+    //! collective, pi and the mesh widths belong to the coarse level
+    AgglomeratedPoisson(const PartitionInformation &pi, double dx2, double dy2, double dz2);
+
+    //! solves Δp = rhs on the whole grid, collective, rhs is indexed without and p with its ghost layer,
+    //! the ghost layers of p are not set and the constant mode of p is 0
+    void solve(FieldVariable &rhs, FieldVariable &p);
+
+protected:
+    //! communicator of the partitions, the rank numbers and rank 0 are the ones of it
+    const MPI_Comm comm_;
+    const int rank_;
+    const std::array<int, 3> nLocal_;
+
+    //! number of cells and first cell of each rank in the gathered buffer, only used on rank 0
+    std::vector<int> counts_;
+    std::vector<int> displacements_;
+    //! node offset and cell count of each rank, 6 entries per rank, only used on rank 0
+    std::vector<int> boxes_;
+
+    std::vector<double> local_;
+    std::vector<double> gathered_;
+
+    //! the grid with its ghost layer and the solver, only allocated on rank 0
+    std::shared_ptr<SubdomainPoisson> solver_;
+    std::shared_ptr<FieldVariable> source_;
+    std::shared_ptr<FieldVariable> solution_;
+};
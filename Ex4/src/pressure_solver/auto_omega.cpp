@@ -0,0 +1,88 @@
+#include "pressure_solver/auto_omega.h"
+
+AutoOmega::AutoOmega(const PartitionInformation &pi, double dx2, double dy2, double dz2, std::string solverName,
+                     int sweepsPerIteration) :
+                     solverName_(solverName), sweepsPerIteration_(sweepsPerIteration), rank_(pi.ownRankNo()),
+                     comm_(pi.comm()), theoreticalOmega_(theoreticalOptimum(pi, dx2, dy2, dz2))
+{ }
+
+double AutoOmega::theoreticalOptimum(const PartitionInformation &pi, double dx2, double dy2, double dz2)
+{
+    // the slowest non-constant mode is the lowest cosine mode of a single direction, constant in the others,
+    // the constant mode is the free constant of the pressure
+    const std::array<int, 3> n = pi.nCellsGlobal();
+    const std::array<double, 3> weights{1. / dx2, 1. / dy2, 1. / dz2};
+    const double sumWeights = weights[0] + weights[1] + weights[2];
+    double mu = 0.0;
+    for(int d = 0; d < 3; d++)
+    {
+        if(n[d] > 1)
+            mu = std::max(mu, (sumWeights - weights[d] * (1. - std::cos(M_PI / n[d]))) / sumWeights);
+    }
+    return 2. / (1. + std::sqrt(1. - mu * mu));
+}
+
+double AutoOmega::initialOmega()
+{
+    lastLoggedOmega_ = theoreticalOmega_;
+    if(rank_ == 0)
+        std::cout << solverName_ << " starts with the theoretical optimum omega = " << theoreticalOmega_ << "\n";
+    return theoreticalOmega_;
+}
+
+void AutoOmega::record(int iteration, double partitionResiduum2)
+{
+    if(iteration == firstIteration_)
+        recorded_[0] = partitionResiduum2;
+    else if(iteration == lastIteration_)
+    {
+        recorded_[1] = partitionResiduum2;
+        reachedLastIteration_ = true;
+    }
+}
+
+double AutoOmega::adapt(double omega)
+{
+    // every rank reaches the same iterations, so all or none of them enter the reduction. The residuum of a single
+    // partition may still be 0, if the correction has not reached it yet, so it does not tell, if the window was reached.
+    if(settled_ || !reachedLastIteration_)
+    {
+        recorded_[0] = 0.0;
+        return omega;
+    }
+    double global[2];
+    MPI_Allreduce(recorded_, global, 2, MPI_DOUBLE, MPI_SUM, comm_);
+    recorded_[0] = 0.0;
+    recorded_[1] = 0.0;
+    reachedLastIteration_ = false;
+
+    // squared residua, so the root of the mean rate per sweep
+    const double lambda = std::pow(global[1] / global[0], 0.5 / ((lastIteration_ - firstIteration_) * sweepsPerIteration_));
+    // above the optimum the rate is omega-1, which results in the same omega, no information either way
+    if(!(lambda > 0.0 && lambda < 1.0))
+        return omega;
+
+    // the partitions are only coupled by their halos, which may break the relation above the optimum,
+    // so if the last adaption made the contraction worse, the best factor so far is kept
+    if(bestLambda_ > 0.0 && lambda > bestLambda_)
+    {
+        settled_ = true;
+        if(rank_ == 0)
+            std::cout << solverName_ << " keeps omega = " << bestOmega_ << " (observed contraction " << lambda 
+                      << " with omega = " << omega << ")\n";
+        return bestOmega_;
+    }
+    bestOmega_ = omega;
+    bestLambda_ = lambda;
+
+    const double mu = std::min((lambda + omega - 1.) / (omega * std::sqrt(lambda)), 1.0);
+    // the optimum is very sensitive close to mu = 1, so it is kept below 2
+    const double adapted = std::max(1.0, std::min(2. / (1. + std::sqrt(1. - mu * mu)), 1.99));
+
+    if(rank_ == 0 && std::abs(adapted - lastLoggedOmega_) > 0.01)
+    {
+        std::cout << solverName_ << " adapted omega to " << adapted << " (observed contraction " << lambda << ")\n";
+        lastLoggedOmega_ = adapted;
+    }
+    return adapted;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <string>
+#include <iostream>
+#include <mpi.h>
+#include "discretization/partition_information.h"
+
+//! Chooses the over-relaxation factor of SOR and Checkerboard at runtime.
+//! It starts with the optimum of the uniform grid, 2/(1+sqrt(1-mu^2)), where mu is the spectral radius of the Jacobi iteration
+//! of the Neumann laplacian. As the partitions couple the sweeps only through their halos, the real contraction is slower,
+//! so the spectral radius is estimated again from the residuum contraction observed in each solve (D. M. Young, 1971):
+//! the SOR rate lambda belongs to mu = (lambda + omega - 1) / (omega sqrt(lambda)).
+//! If an adaption makes the contraction worse, the best factor so far is kept for the rest of the run.
+class AutoOmega
+{
+public:
+    //! the solver name is only used to log the chosen factors, sweepsPerIteration is the number of
+    //! red-black or lexicographic sweeps of one iteration of the solver
+    AutoOmega(const PartitionInformation &pi, double dx2, double dy2, double dz2, std::string solverName,
+              int sweepsPerIteration = 1);
+
+    //! optimal factor of the red-black and lexicographic SOR on the global grid
+    static double theoreticalOptimum(const PartitionInformation &pi, double dx2, double dy2, double dz2);
+
+    //! the initial factor, which is also logged
+    double initialOmega();
+
+    //! remembers the squared partition residuum of the iterate, the given iteration started from
+    void record(int iteration, double partitionResiduum2);
+
+    //! reduces the residua recorded during the last solve and returns the improved factor,
+    //! has to be called by all ranks at the same iteration, i.e. at the beginning of a solve
+    double adapt(double omega);
+
+private:
+    const std::string solverName_;
+    const int sweepsPerIteration_;
+    const int rank_;
+    //! communicator of the partitions, the residua are reduced over it
+    const MPI_Comm comm_;
+    const double theoreticalOmega_;
+
+    //! the contraction is measured between these iterations, the first ones are dominated by the fast modes
+    static constexpr int firstIteration_ = 10;
+    static constexpr int lastIteration_ = 30;
+
+    //! partition residua at the first and last iteration of the window, 0 if not reached
+    double recorded_[2] = {0.0, 0.0};
+    //! the last solve reached lastIteration_, the same on all ranks, unlike the residuum of a partition
+    bool reachedLastIteration_ = false;
+    //! last logged factor, small changes are not logged
+    double lastLoggedOmega_ = 0.0;
+    //! factor with the smallest contraction so far
+    double bestOmega_ = 0.0;
+    double bestLambda_ = 0.0;
+    //! set, once an adaption made the contraction worse, then omega is not changed anymore
+    bool settled_ = false;
+};
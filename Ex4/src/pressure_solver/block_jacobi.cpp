@@ -0,0 +1,44 @@
+#include "pressure_solver/block_jacobi.h"
+
+BlockJacobi::BlockJacobi(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations) :
+                         PressureSolver(partition, epsilon, maximumNumberOfIterations),
+                         subdomainSolver_(partition->pi_, discretization_->dx2(), discretization_->dy2(), discretization_->dz2())
+{
+    discretization_->makeCGFields();
+    providesSweepResiduum_ = true;
+}
+
+void BlockJacobi::step()
+{
+    // same residuum as in PCG, r = -rhs - (-Δp), the ghost layers of p were set in solve
+    const double dx2 = discretization_->dx2();
+    const double dy2 = discretization_->dy2();
+    const double dz2 = discretization_->dz2();
+    const Array3DView p = discretization_->pView(), b = discretization_->rhsView();
+    const Array3DView r = discretization_->cellView(discretization_->r());
+    const Array3DView z = discretization_->cellView(discretization_->z());
+    double residuum2 = 0.0;
+    for(int k = 0; k < discretization_->pkN(); k++)
+    {
+        for(int j = 0; j < discretization_->pjN(); j++)
+        {
+            for(int i = 0; i < discretization_->piN(); i++)
+            {
+                const double D2pDx2 = (p(i+1,j,k) - 2.*p(i,j,k) + p(i-1,j,k)) / dx2;
+                const double D2pDy2 = (p(i,j+1,k) - 2.*p(i,j,k) + p(i,j-1,k)) / dy2;
+                const double D2pDz2 = (p(i,j,k+1) - 2.*p(i,j,k) + p(i,j,k-1)) / dz2;
+                const double residuum = D2pDx2 + D2pDy2 + D2pDz2 - b(i,j,k);
+                r(i,j,k) = residuum;
+                residuum2 += residuum*residuum;
+            }
+        }
+    }
+    sweepResiduum2_ = residuum2;
+
+    subdomainSolver_.solve(discretization_->r(), discretization_->z());
+
+    for(int k = 0; k < discretization_->pkN(); k++)
+        for(int j = 0; j < discretization_->pjN(); j++)
+            for(int i = 0; i < discretization_->piN(); i++)
+                p(i,j,k) += z(i,j,k);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <memory>
+#include <cmath>
+#include <exception>
+#include <sstream>
+#include <mpi.h>
+#include "pressure_solver/pressure_solver.h"
+#include "pressure_solver/subdomain_poisson.h"
+#include "discretization/discretization.h"
+#include "discretization/partition_shell.h"
+#include "storage/field_variable.h"
+
+//! Non-overlapping additive Schwarz iteration: each step solves the residual equation on every partition
+//! exactly with SubdomainPoisson and adds the correction, so only the halo of p set in solve is exchanged per step.
+//! The partitions are coupled through the residuum only, the number of steps grows with the number of partitions
+//! along a direction, used as the preconditioner "Subdomain" of PCG the coupling is accelerated by CG.
+class BlockJacobi : public PressureSolver
+{
+public:
+    BlockJacobi(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations);
+
+    //! one subdomain solve, the residuum of the iterate it started from is summed up on the way
+    void step() override;
+
+protected:
+    SubdomainPoisson subdomainSolver_;
+};
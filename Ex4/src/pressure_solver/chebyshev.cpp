@@ -0,0 +1,139 @@
+#include "pressure_solver/chebyshev.h"
+
+Chebyshev::Chebyshev(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations,
+                     double lowerBoundFraction) :
+                     PressureSolver(partition, epsilon, maximumNumberOfIterations),
+                     direction_({discretization_->piN(), discretization_->pjN(), discretization_->pkN()}, "chebyshev.direction")
+{
+    if(lowerBoundFraction < 0.0 || lowerBoundFraction >= 1.0)
+    {
+        std::stringstream str;
+        str << "The lower bound fraction of the Chebyshev iteration may only be 0.0 <= " << lowerBoundFraction << " < 1.0!\n";
+        throw std::out_of_range(str.str());
+    }
+    std::array<double, 2> bounds = eigenvalueBounds(partition_->pi_, discretization_->dx2(), discretization_->dy2(), discretization_->dz2());
+    if(lowerBoundFraction > 0.0)
+        bounds[0] = lowerBoundFraction * bounds[1];
+    theta_ = (bounds[1] + bounds[0]) / 2.;
+    delta_ = (bounds[1] - bounds[0]) / 2.;
+    sigma_ = theta_ / delta_;
+    providesSweepResiduum_ = true;
+    overlapsHaloOfP_ = true;
+}
+
+std::array<double, 2> Chebyshev::eigenvalueBounds(const PartitionInformation &pi, double dx2, double dy2, double dz2)
+{
+    // the eigenvalues of the Jacobi iteration are the weighted means of cos(pi k_d / n_d), k_d = 0..n_d-1,
+    // the largest one below 1 has k_d = 1 in one direction and k = 0 in the others, the smallest one all k_d = n_d-1
+    const std::array<int, 3> n = pi.nCellsGlobal();
+    const std::array<double, 3> weights{1. / dx2, 1. / dy2, 1. / dz2};
+    const double sumWeights = weights[0] + weights[1] + weights[2];
+    double muMax = 0.0;
+    double muMin = 0.0;
+    for(int d = 0; d < 3; d++)
+    {
+        // a single cell only has the constant mode
+        if(n[d] > 1)
+            muMax = std::max(muMax, sumWeights - weights[d] * (1. - std::cos(M_PI / n[d])));
+        muMin += ((n[d] > 1) ? -std::cos(M_PI / n[d]) : 1.0) * weights[d];
+    }
+    muMax /= sumWeights;
+    muMin /= sumWeights;
+    return {1. - muMax, 1. - muMin};
+}
+
+void Chebyshev::step()
+{
+    // the polynomial restarts with each solve
+    double directionScale, correctionScale;
+    if(iteration_ == 0)
+    {
+        rho_ = 1. / sigma_;
+        directionScale = 0.0;
+        correctionScale = 1. / theta_;
+    }
+    else
+    {
+        const double rho = 1. / (2. * sigma_ - rho_);
+        directionScale = rho * rho_;
+        correctionScale = 2. * rho / delta_;
+        rho_ = rho;
+    }
+
+    const int kN = discretization_->pkN();
+    double residuum2 = 0.0;
+    if(useOverlappedComm_)
+    {
+        // The interior only reads cells of the partition and the Neumann ghost layers set by start, so the halo of p
+        // is exchanged meanwhile. p is only updated, after the shell has read the halo.
+        FieldVariable &p = discretization_->p();
+        partition_->startBoundaryCellField(p);
+        for(int k = 0; k < kN; k++)
+            residuum2 += updateDirection(k, GridRegion::Interior, directionScale, correctionScale);
+        partition_->finishBoundaryCellField(p);
+        for(int k = 0; k < kN; k++)
+            residuum2 += updateDirection(k, GridRegion::Shell, directionScale, correctionScale);
+        for(int k = 0; k < kN; k++)
+            updatePlane(k);
+    }
+    else
+    {
+        // p of a plane is only updated after the next plane, which is the last one reading it, is done
+        for(int k = 0; k < kN; k++)
+        {
+            residuum2 += updateDirection(k, GridRegion::All, directionScale, correctionScale);
+            if(k > 0)
+                updatePlane(k-1);
+        }
+        updatePlane(kN-1);
+    }
+    // the corrections are the residua scaled with the inverse diagonal
+    const double dx2 = discretization_->dx2();
+    const double dy2 = discretization_->dy2();
+    const double dz2 = discretization_->dz2();
+    const double factor = (dx2 * dy2 * dz2) / (2. * (dy2*dz2+dx2*dz2+dx2*dy2));
+    sweepResiduum2_ = residuum2 / (factor * factor);
+}
+
+double Chebyshev::updateDirection(int k, GridRegion region, double directionScale, double correctionScale)
+{
+    const double dx2 = discretization_->dx2();
+    const double dy2 = discretization_->dy2();
+    const double dz2 = discretization_->dz2();
+    const double factor = (dx2 * dy2 * dz2) / (2. * (dy2*dz2+dx2*dz2+dx2*dy2));
+    const Array3DView p = discretization_->pView(), b = discretization_->rhsView(), direction = direction_.view();
+    const int iN = discretization_->piN(), jN = discretization_->pjN(), kN = discretization_->pkN();
+
+    double residuum2 = 0.0;
+    for(int j = 0; j < jN; j++)
+    {
+        forRowSegments(region, discretization_->shellWidth(), j, k, iN, jN, kN, [&](int iBegin, int iEnd)
+        {
+            for(int i = iBegin; i < iEnd; i++)
+            {
+                const double p_last = p(i,j,k);
+                const double p_xm   = p(i-1,j,k);
+                const double p_xp   = p(i+1,j,k);
+                const double p_ym   = p(i,j-1,k);
+                const double p_yp   = p(i,j+1,k);
+                const double p_zm   = p(i,j,k-1);
+                const double p_zp   = p(i,j,k+1);
+                const double rhs    = b(i,j,k);
+
+                // the Jacobi correction is the residuum scaled with the inverse diagonal
+                const double p_corretion = factor * ((p_xm+p_xp)/dx2 + (p_ym+p_yp)/dy2 + (p_zm+p_zp)/dz2 - rhs) - p_last;
+                direction(i,j,k) = directionScale * direction(i,j,k) + correctionScale * p_corretion;
+                residuum2 += p_corretion * p_corretion;
+            }
+        });
+    }
+    return residuum2;
+}
+
+void Chebyshev::updatePlane(int k)
+{
+    const Array3DView p = discretization_->pView(), direction = direction_.view();
+    for(int j = 0; j < discretization_->pjN(); j++)
+        for(int i = 0; i < discretization_->piN(); i++)
+            p(i,j,k) += direction(i,j,k);
+}
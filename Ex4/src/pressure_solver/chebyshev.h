@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <cmath>
+#include <array>
+#include <algorithm>
+#include <exception>
+#include <sstream>
+#include <mpi.h>
+#include "pressure_solver/pressure_solver.h"
+#include "discretization/discretization.h"
+#include "discretization/partition_shell.h"
+#include "storage/array3D.h"
+
+//! Chebyshev semi-iterative acceleration of the Jacobi iteration (Y. Saad, Iterative Methods for Sparse Linear Systems, Alg. 12.1).
+//! The coefficients only depend on the bounds of the spectrum of the Jacobi preconditioned laplacian,
+//! which are known from its cosine eigenmodes, so the steps themselves do not need any inner product.
+//! Combined with residuumCheckInterval and useSweepResiduum, many steps run between two global reductions.
+//! The Jacobi update is independent of the partitioning, each step only needs the halo of p set by solve.
+//! With useOverlappedComm the step exchanges the halo of p itself, while it updates the interior.
+class Chebyshev : public PressureSolver
+{
+public:
+    //! A lowerBoundFraction > 0 only targets the eigenvalues in [lowerBoundFraction*lambdaMax, lambdaMax],
+    //! which turns the solver into a smoother for the high frequencies, 0 uses the whole spectrum
+    Chebyshev(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations,
+              double lowerBoundFraction = 0.0);
+
+    //! one Jacobi sweep with the Chebyshev weights, which also sums up the residuum of the iterate it started from
+    void step() override;
+
+    //! bounds of the spectrum of the Jacobi preconditioned negative laplacian without the constant mode
+    static std::array<double, 2> eigenvalueBounds(const PartitionInformation &pi, double dx2, double dy2, double dz2);
+
+protected:
+    //! updates the direction of the region of the k-th plane, returns the sum of the squared Jacobi corrections
+    double updateDirection(int k, GridRegion region, double directionScale, double correctionScale);
+
+    //! adds the direction of the k-th plane onto p
+    void updatePlane(int k);
+
+    //! centre and half width of the eigenvalue interval and their ratio
+    double theta_;
+    double delta_;
+    double sigma_;
+    //! recurrence coefficient of the last step
+    double rho_ = 0.0;
+
+    //! last update of p, without ghost layers
+    Array3D direction_;
+};
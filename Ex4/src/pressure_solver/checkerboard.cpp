@@ -1,9 +1,11 @@
 #include "pressure_solver/checkerboard.h"
 
 Checkerboard::Checkerboard(std::shared_ptr<PartitionShell> partition, 
-         double epsilon, int maximumNumberOfIterations, double omega) :
+         double epsilon, int maximumNumberOfIterations, double omega, bool autoOmega) :
          PressureSolver(partition, epsilon, maximumNumberOfIterations),
-         omega_(omega)
+         omega_(omega), autoOmega_(autoOmega),
+         omegaTuner_(partition->pi_, discretization_->dx2(), discretization_->dy2(), discretization_->dz2(), "Checkerboard"),
+         rowKernel_(RedBlackKernel::select())
 {
     // Other omegas are likely to lead to instability
     if(omega <= 0.0 || omega >= 2.0)
@@ -12,6 +14,10 @@ Checkerboard::Checkerboard(std::shared_ptr<PartitionShell> partition,
         str << "Omega may only be 0.0 < "  << omega << " < 2.0!\n";
         throw std::out_of_range(str.str());
     }
+    providesSweepResiduum_ = true;
+    overlapsHaloOfP_ = true;
+    if(autoOmega_)
+        omega_ = omegaTuner_.initialOmega();
 }
 
 //! Works similar to SOR, but in two steps
@@ -22,49 +28,69 @@ inline void Checkerboard::step()
     const double dz2 = discretization_->dz2();
 
     const double factor = (dx2 * dy2 * dz2) / (2. * (dy2*dz2+dx2*dz2+dx2*dy2));
-    const int nodeOffset = partition_->pi_.nodeOffset()[0] + partition_->pi_.nodeOffset()[1];
-    
-    for(int k=0; k<discretization_->pkN(); k++) {
-        for(int j = 0; j < discretization_->pjN(); j++) {
-            const int offset = (k & 0b1) ^ (j & 0b1);
-            for(int i = offset; i < discretization_->piN(); i += 2) {
-                // store all variables with short name for readibilty
-                const double p_last = discretization_->p(i,j,k);
-                const double p_xm   = discretization_->p(i-1,j,k);
-                const double p_xp   = discretization_->p(i+1,j,k);
-                const double p_ym   = discretization_->p(i,j-1,k);
-                const double p_yp   = discretization_->p(i,j+1,k);
-                const double p_zm   = discretization_->p(i,j,k-1);
-                const double p_zp   = discretization_->p(i,j,k+1);
-                const double rhs    = discretization_->rhs(i,j,k);
+    if(autoOmega_ && iteration_ == 0)
+        omega_ = omegaTuner_.adapt(omega_);
+    const RedBlackCoefficients coefficients{1. / dx2, 1. / dy2, 1. / dz2, factor, omega_};
+    // the correction is the residuum scaled by -factor, the red cells see the previous iterate,
+    // the black cells already the updated red neighbours
+    double correction2 = 0.0;
 
-                const double p_corretion = factor * ((p_xm+p_xp)/dx2 + (p_ym+p_yp)/dy2 + (p_zm+p_zp)/dz2 - rhs) - p_last;
-
-                const double p_new = p_last + omega_ * p_corretion;
-                discretization_->p(i, j, k) = p_new;
-            }
-        }
+    if(useOverlappedComm_)
+    {
+        // The interior of a colour only reads cells of the partition and the Neumann ghost layers set by start,
+        // so the halo of the previous black cells is exchanged during the red interior and the halo of the red
+        // cells during the black interior.
+        // The shell is relaxed after the ghost layers arrived and before it is sent.
+        FieldVariable &p = discretization_->p();
+        partition_->startBoundaryCellField(p);
+        correction2 += relax(0, GridRegion::Interior, coefficients);
+        partition_->finishBoundaryCellField(p);
+        correction2 += relax(0, GridRegion::Shell, coefficients);
+        partition_->startExchangeCellField(p);
+        correction2 += relax(1, GridRegion::Interior, coefficients);
+        partition_->finishExchangeCellField(p);
+        correction2 += relax(1, GridRegion::Shell, coefficients);
     }
-    partition_->exchangeP();
-
-    for(int k=0; k<discretization_->pkN(); k++) {
-        for(int j = 0; j < discretization_->pjN(); j++) {
-            const int offset = ((k & 0b1) ^ (j & 0b1)) ^ 0b1;   // flip the LSB compared to the first step
-            for(int i = offset; i < discretization_->piN(); i += 2) {
-                const double p_last = discretization_->p(i,j,k);
-                const double p_xm   = discretization_->p(i-1,j,k);
-                const double p_xp   = discretization_->p(i+1,j,k);
-                const double p_ym   = discretization_->p(i,j-1,k);
-                const double p_yp   = discretization_->p(i,j+1,k);
-                const double p_zm   = discretization_->p(i,j,k-1);
-                const double p_zp   = discretization_->p(i,j,k+1);
-                const double rhs    = discretization_->rhs(i,j,k);
+    else
+    {
+        correction2 += relax(0, GridRegion::All, coefficients);
+        partition_->exchangeP();
+        correction2 += relax(1, GridRegion::All, coefficients);
+    }
+    sweepResiduum2_ = correction2 / (factor * factor);
+    if(autoOmega_)
+        omegaTuner_.record(iteration_, sweepResiduum2_);
+}
 
-                const double p_corretion = factor * ((p_xm+p_xp)/dx2 + (p_ym+p_yp)/dy2 + (p_zm+p_zp)/dz2 - rhs) - p_last;
+double Checkerboard::relax(int colour, GridRegion region, const RedBlackCoefficients &coefficients)
+{
+    const Array3DView p = discretization_->pView(), b = discretization_->rhsView();
+    const std::ptrdiff_t sy = p.strideY(), sz = p.strideZ();
+    const int iN = discretization_->piN(), jN = discretization_->pjN(), kN = discretization_->pkN();
+    double correction2 = 0.0;
 
-                const double p_new = p_last + omega_ * p_corretion;
-                discretization_->p(i, j, k) = p_new;
-            }
+    // the cells of one colour are independent, so the planes and rows are distributed over the threads
+    #pragma omp parallel for collapse(2) reduction(+:correction2)
+    for(int k = 0; k < kN; k++)
+    {
+        for(int j = 0; j < jN; j++)
+        {
+            // the black cells flip the LSB compared to the red ones
+            const int first = ((k & 0b1) ^ (j & 0b1)) ^ colour;
+            forRowSegments(region, discretization_->shellWidth(), j, k, iN, jN, kN, [&](int iBegin, int iEnd)
+            {
+                // the first and last cell of the rows in the shell are not worth a call of the row kernel
+                if(iEnd - iBegin == 1)
+                {
+                    if((iBegin & 0b1) == first)
+                        correction2 += RedBlackKernel::cell(p.row(iBegin,j,k), b.row(iBegin,j,k), sy, sz, coefficients);
+                    return;
+                }
+                // the kernel counts the cells from the start of the segment
+                correction2 += rowKernel_(p.row(iBegin,j,k), b.row(iBegin,j,k), sy, sz,
+                                          first ^ (iBegin & 0b1), iEnd - iBegin, coefficients);
+            });
         }
     }
-}
\ No newline at end of file
+    return correction2;
+}
@@ -5,14 +5,25 @@
 #include <sstream>
 #include <mpi.h>
 #include "pressure_solver/pressure_solver.h"
+#include "pressure_solver/auto_omega.h"
+#include "pressure_solver/red_black_kernel.h"
 #include "discretization/discretization.h"
 #include "discretization/partition_shell.h"
 #include "storage/field_variable.h"
 
 class Checkerboard : public PressureSolver {
 public:
-    Checkerboard(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations, double omega);
+    //! with autoOmega, omega is replaced by the optimum of the grid and adapted to the observed contraction
+    Checkerboard(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations, double omega,
+        bool autoOmega = false);
     void step() override;
 protected:
-    const double omega_;
+    //! relaxes the cells of the colour in the region, returns their summed up squared corrections
+    double relax(int colour, GridRegion region, const RedBlackCoefficients &coefficients);
+
+    double omega_;
+    const bool autoOmega_;
+    AutoOmega omegaTuner_;
+    //! relaxes the cells of one colour in a row, chosen by the CPU capabilities
+    const RedBlackRowKernel rowKernel_;
 };
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "pressure_solver/dct.h"
+
+#ifdef FFTW
+
+DCT::DCT(int n) : n_(n), buffer_(n)
+{
+    if(n < 1)
+    {
+        std::stringstream str;
+        str << "The DCT requires a positive length, but got " << n << "!\n";
+        throw std::out_of_range(str.str());
+    }
+    // REDFT10 is the (doubled) DCT-II, REDFT01 the corresponding DCT-III, the lines are not aligned
+    forwardPlan_ = fftw_plan_r2r_1d(n_, buffer_.data(), buffer_.data(), FFTW_REDFT10, FFTW_MEASURE | FFTW_UNALIGNED);
+    backwardPlan_ = fftw_plan_r2r_1d(n_, buffer_.data(), buffer_.data(), FFTW_REDFT01, FFTW_MEASURE | FFTW_UNALIGNED);
+}
+
+DCT::~DCT()
+{
+    fftw_destroy_plan(forwardPlan_);
+    fftw_destroy_plan(backwardPlan_);
+}
+
+void DCT::forward(double *line)
+{
+    fftw_execute_r2r(forwardPlan_, line, line);
+}
+
+void DCT::backward(double *line)
+{
+    fftw_execute_r2r(backwardPlan_, line, line);
+    // REDFT01(REDFT10(x)) = 2n * x
+    const double scale = 1. / (2. * n_);
+    for(int i = 0; i < n_; i++)
+        line[i] *= scale;
+}
+
+#else
+
+DCT::DCT(int n) : n_(n), roots_(n), shift_(n), permuted_(n), transformed_(n)
+{
+    if(n < 1)
+    {
+        std::stringstream str;
+        str << "The DCT requires a positive length, but got " << n << "!\n";
+        throw std::out_of_range(str.str());
+    }
+
+    int remainder = n;
+    for(int p = 2; p*p <= remainder; p++)
+    {
+        while(remainder % p == 0)
+        {
+            factors_.push_back(p);
+            remainder /= p;
+        }
+    }
+    if(remainder > 1)
+        factors_.push_back(remainder);
+    butterfly_.resize(factors_.empty() ? 1 : factors_.back());
+
+    for(int j = 0; j < n_; j++)
+    {
+        roots_[j] = std::polar(1.0, -2. * M_PI * j / n_);
+        shift_[j] = std::polar(1.0, -M_PI * j / (2. * n_));
+    }
+}
+
+DCT::~DCT() { }
+
+void DCT::forward(double *line)
+{
+    // even entries ascending from the front, odd entries descending from the back
+    for(int m = 0; m < n_; m++)
+    {
+        if(m % 2 == 0)
+            permuted_[m/2] = line[m];
+        else
+            permuted_[n_-1 - (m-1)/2] = line[m];
+    }
+    fft(permuted_.data(), 1, transformed_.data(), n_, 0, false);
+    for(int k = 0; k < n_; k++)
+        line[k] = std::real(shift_[k] * transformed_[k]);
+}
+
+void DCT::backward(double *line)
+{
+    // the FFT of the real permuted line is hermitian, so X_k and X_{n-k} determine its k-th entry
+    transformed_[0] = line[0];
+    for(int k = 1; k < n_; k++)
+        transformed_[k] = std::conj(shift_[k]) * std::complex<double>(line[k], -line[n_-k]);
+    fft(transformed_.data(), 1, permuted_.data(), n_, 0, true);
+    for(int m = 0; m < n_; m++)
+    {
+        if(m % 2 == 0)
+            line[m] = std::real(permuted_[m/2]) / n_;
+        else
+            line[m] = std::real(permuted_[n_-1 - (m-1)/2]) / n_;
+    }
+}
+
+void DCT::fft(const std::complex<double> *in, int stride, std::complex<double> *out, int n, int factor, bool inverse)
+{
+    if(n == 1)
+    {
+        out[0] = in[0];
+        return;
+    }
+
+    // the p subsequences with stride p are transformed into consecutive blocks of length m
+    const int p = factors_[factor];
+    const int m = n / p;
+    for(int r = 0; r < p; r++)
+        fft(in + r*stride, stride*p, out + r*m, m, factor+1, inverse);
+
+    // roots of unity of length n are every (n_/n)-th root of length n_, r*k < n, so they are always in range
+    const int rootStride = n_ / n;
+    const int primeRootStride = n_ / p;
+    for(int k = 0; k < m; k++)
+    {
+        for(int r = 0; r < p; r++)
+        {
+            const std::complex<double> twiddle = roots_[r * k * rootStride];
+            butterfly_[r] = out[r*m + k] * (inverse ? std::conj(twiddle) : twiddle);
+        }
+        // the radix 2 butterfly is the most common one
+        if(p == 2)
+        {
+            out[k] = butterfly_[0] + butterfly_[1];
+            out[m + k] = butterfly_[0] - butterfly_[1];
+            continue;
+        }
+        // naive DFT of length p, which is fine, as p is a prime factor
+        for(int q = 0; q < p; q++)
+        {
+            std::complex<double> sum = butterfly_[0];
+            for(int r = 1; r < p; r++)
+            {
+                const std::complex<double> root = roots_[((r * q) % p) * primeRootStride];
+                sum += butterfly_[r] * (inverse ? std::conj(root) : root);
+            }
+            out[q*m + k] = sum;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <exception>
+#include <sstream>
+#ifdef FFTW
+#include <fftw3.h>
+#endif
+
+//! Discrete cosine transform of type II, X_k = sum_j x_j cos(pi k (j+1/2) / n), and its exact inverse for lines of a fixed length.
+//! Its basis vectors are the eigenvectors of the 1D laplacian with homogeneous Neumann boundaries on a cell-centred grid.
+//! If compiled with FFTW, its real-to-real transforms are used, otherwise the transform is calculated with
+//! a self-contained mixed-radix FFT of the same length (J. Makhoul, 1980), so any length is supported in O(n log n),
+//! as long as it does not contain large prime factors.
+class DCT
+{
+public:
+    DCT(int n);
+    ~DCT();
+
+    //! the plans are bound to the buffers of this object
+    DCT(const DCT &) = delete;
+    DCT &operator=(const DCT &) = delete;
+
+    //! transforms the line of length n in place
+    void forward(double *line);
+
+    //! inverse of forward, also in place
+    void backward(double *line);
+
+    inline int length() const { return n_; }
+
+private:
+    const int n_;
+
+    #ifdef FFTW
+    fftw_plan forwardPlan_;
+    fftw_plan backwardPlan_;
+    std::vector<double> buffer_;
+    #else
+    //! recursive decimation in time FFT over the factors starting at factor, in has a stride, out is contiguous
+    void fft(const std::complex<double> *in, int stride, std::complex<double> *out, int n, int factor, bool inverse);
+
+    //! prime factors of n_, smallest first
+    std::vector<int> factors_;
+    //! exp(-2 pi i j / n_) for all j
+    std::vector<std::complex<double>> roots_;
+    //! exp(-pi i k / (2 n_)), which shifts the FFT of the permuted line onto the cosine transform
+    std::vector<std::complex<double>> shift_;
+    std::vector<std::complex<double>> permuted_;
+    std::vector<std::complex<double>> transformed_;
+    //! one butterfly of the largest prime factor
+    std::vector<std::complex<double>> butterfly_;
+    #endif
+};
@@ -0,0 +1,140 @@
+#include "pressure_solver/deep_halo_checkerboard.h"
+
+DeepHaloCheckerboard::DeepHaloCheckerboard(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations,
+                                           double omega, int haloDepth, bool autoOmega) :
+                                           PressureSolver(partition, epsilon, maximumNumberOfIterations),
+                                           omega_(omega), autoOmega_(autoOmega),
+                                           omegaTuner_(partition->pi_, discretization_->dx2(), discretization_->dy2(),
+                                                       discretization_->dz2(), "DeepHaloCheckerboard", haloDepth / 2),
+                                           depth_(haloDepth),
+                                           parityOffset_((partition->pi_.nodeOffset()[0] + partition->pi_.nodeOffset()[1] 
+                                                        + partition->pi_.nodeOffset()[2] - 3*haloDepth) & 0b1)
+{
+    if(omega <= 0.0 || omega >= 2.0)
+    {
+        std::stringstream str;
+        str << "Omega may only be 0.0 < "  << omega << " < 2.0!\n";
+        throw std::out_of_range(str.str());
+    }
+    if(haloDepth < 2 || haloDepth % 2 != 0)
+    {
+        std::stringstream str;
+        str << "The halo depth of the deep halo checkerboard has to be even and at least 2, but is " << haloDepth << "!\n";
+        throw std::out_of_range(str.str());
+    }
+    // the neighbours may be a little smaller, their whole halo has to come from their interior
+    int maximumDepth = partition_->pi_.maximumHaloDepth();
+    MPI_Allreduce(MPI_IN_PLACE, &maximumDepth, 1, MPI_INT, MPI_MIN, partition_->pi_.comm());
+    if(haloDepth > maximumDepth)
+    {
+        std::stringstream str;
+        str << "The halo depth " << haloDepth << " exceeds the smallest partition size " << maximumDepth << "!\n";
+        throw std::out_of_range(str.str());
+    }
+    discretization_->makeDeepHaloP(haloDepth);
+
+    const PartitionInformation &pi = partition_->pi_;
+    lowerNeighbour_ = {!pi.ownLeftBoundary(), !pi.ownBottomBoundary(), !pi.ownHindBoundary()};
+    upperNeighbour_ = {!pi.ownRightBoundary(), !pi.ownTopBoundary(), !pi.ownFrontBoundary()};
+    keepsOwnHalo_ = true;
+    if(autoOmega_)
+        omega_ = omegaTuner_.initialOmega();
+}
+
+void DeepHaloCheckerboard::step()
+{
+    FieldVariable &deepP = discretization_->deepP();
+    const std::array<int, 3> size = deepP.size();
+    // the origin of the deep views is the first cell of the partition, like the one of p
+    const Array3DView p = discretization_->pView(), deepPView = deepP.view(depth_, depth_, depth_);
+    const int iN = discretization_->piN();
+    const int jN = discretization_->pjN();
+    const int kN = discretization_->pkN();
+    // the contraction of the last solve is evaluated before omega is used by any rank in this solve
+    if(autoOmega_ && iteration_ == 0)
+        omega_ = omegaTuner_.adapt(omega_);
+
+    // the deep copies are only synchronized at the beginning of each solve, p may have been changed in between,
+    // e.g. by the extrapolated guess, the rhs of the halo is needed for the redundant updates
+    if(iteration_ == 0)
+    {
+        FieldVariable &deepRhs = discretization_->deepRhs();
+        const Array3DView b = discretization_->rhsView(), deepRhsView = deepRhs.view(depth_, depth_, depth_);
+        for(int k = 0; k < kN; k++)
+        {
+            for(int j = 0; j < jN; j++)
+            {
+                for(int i = 0; i < iN; i++)
+                {
+                    deepPView(i,j,k) = p(i,j,k);
+                    deepRhsView(i,j,k) = b(i,j,k);
+                }
+            }
+        }
+        partition_->exchangeDeepCellField(deepRhs, depth_);
+    }
+
+    partition_->exchangeDeepCellField(deepP, depth_);
+
+    // after the exchange the whole halo is valid, each half sweep can update one layer less, at walls only the partition
+    double correction2 = 0.0;
+    for(int halfSweep = 0; halfSweep < depth_; halfSweep++)
+    {
+        std::array<int, 3> begin, end;
+        for(int d = 0; d < 3; d++)
+        {
+            begin[d] = lowerNeighbour_[d] ? halfSweep + 1 : depth_;
+            end[d] = upperNeighbour_[d] ? size[d] - halfSweep - 1 : size[d] - depth_;
+        }
+        // the redundant updates are exact, so within the partition the corrections of the last red-black iteration
+        // are the ones of Checkerboard, i.e. the residuum of the iterate this iteration started from
+        const double halfSweepCorrection2 = relaxColour(halfSweep % 2, begin, end);
+        if(halfSweep >= depth_ - 2)
+            correction2 += halfSweepCorrection2;
+        partition_->setDirichletDeepCellField(deepP, depth_);
+    }
+    if(autoOmega_)
+    {
+        const double dx2 = discretization_->dx2();
+        const double dy2 = discretization_->dy2();
+        const double dz2 = discretization_->dz2();
+        const double factor = (dx2 * dy2 * dz2) / (2. * (dy2*dz2+dx2*dz2+dx2*dy2));
+        omegaTuner_.record(iteration_, correction2 / (factor * factor));
+    }
+
+    for(int k = 0; k < kN; k++)
+        for(int j = 0; j < jN; j++)
+            for(int i = 0; i < iN; i++)
+                p(i,j,k) = deepPView(i,j,k);
+}
+
+double DeepHaloCheckerboard::relaxColour(int colour, const std::array<int, 3> &begin, const std::array<int, 3> &end)
+{
+    const double dx2 = discretization_->dx2();
+    const double dy2 = discretization_->dy2();
+    const double dz2 = discretization_->dz2();
+    const double factor = (dx2 * dy2 * dz2) / (2. * (dy2*dz2+dx2*dz2+dx2*dy2));
+    const Array3DView p = discretization_->deepP().view(), rhs = discretization_->deepRhs().view();
+    const std::array<int, 3> size = discretization_->deepP().size();
+    double correction2 = 0.0;
+
+    for(int k = begin[2]; k < end[2]; k++)
+    {
+        for(int j = begin[1]; j < end[1]; j++)
+        {
+            // the first cell of the row with the global colour
+            const int i0 = begin[0] + ((begin[0] + j + k + parityOffset_ + colour) & 0b1);
+            const bool rowInPartition = j >= depth_ && j < size[1] - depth_ && k >= depth_ && k < size[2] - depth_;
+            for(int i = i0; i < end[0]; i += 2)
+            {
+                const double p_last = p(i,j,k);
+                const double p_corretion = factor * ((p(i-1,j,k)+p(i+1,j,k))/dx2 + (p(i,j-1,k)+p(i,j+1,k))/dy2 
+                                                   + (p(i,j,k-1)+p(i,j,k+1))/dz2 - rhs(i,j,k)) - p_last;
+                p(i,j,k) = p_last + omega_ * p_corretion;
+                if(rowInPartition && i >= depth_ && i < size[0] - depth_)
+                    correction2 += p_corretion * p_corretion;
+            }
+        }
+    }
+    return correction2;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+#include <array>
+#include <cmath>
+#include <exception>
+#include <sstream>
+#include <mpi.h>
+#include "pressure_solver/pressure_solver.h"
+#include "pressure_solver/auto_omega.h"
+#include "discretization/discretization.h"
+#include "discretization/partition_shell.h"
+#include "storage/field_variable.h"
+
+//! Red-black SOR on a copy of p with haloDepth ghost layers. After one exchange of the deep halo,
+//! each half sweep also relaxes the part of the halo, which is still valid, so the halo shrinks by one layer
+//! per half sweep and haloDepth half sweeps are done before the next exchange.
+//! The redundant updates of the halo are the same the neighbours calculate, so the colouring is global
+//! and the result does not depend on the partitioning. One step are haloDepth/2 red-black iterations.
+class DeepHaloCheckerboard : public PressureSolver
+{
+public:
+    //! the halo depth has to be even, as each step consists of complete red-black iterations,
+    //! with autoOmega, omega is replaced by the optimum of the grid and adapted to the observed contraction
+    DeepHaloCheckerboard(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations,
+                         double omega, int haloDepth, bool autoOmega = false);
+
+    void step() override;
+
+protected:
+    //! relaxes all cells of one colour in the box [begin, end) of the deep field,
+    //! returns the sum of the squared corrections of the cells of the partition
+    double relaxColour(int colour, const std::array<int, 3> &begin, const std::array<int, 3> &end);
+
+    double omega_;
+    const bool autoOmega_;
+    //! measures the contraction with the corrections of the last red-black iteration of each step
+    AutoOmega omegaTuner_;
+    const int depth_;
+    //! parity of the global index of the first deep halo cell
+    const int parityOffset_;
+    //! if there is a neighbour instead of a wall on the lower and upper side of each direction
+    std::array<bool, 3> lowerNeighbour_;
+    std::array<bool, 3> upperNeighbour_;
+};
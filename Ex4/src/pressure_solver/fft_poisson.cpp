@@ -0,0 +1,197 @@
+#include "pressure_solver/fft_poisson.h"
+
+FFTPoisson::FFTPoisson(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations) :
+                       PressureSolver(partition, epsilon, maximumNumberOfIterations)
+{
+    const PartitionInformation &pi = partition_->pi_;
+    const std::array<int, 3> nLocal = pi.nCellsLocal();
+    const std::array<int, 3> nGlobal = pi.nCellsGlobal();
+    const std::array<int, 3> offset = pi.nodeOffset();
+    const std::array<int, 3> strides{1, nLocal[0], nLocal[0]*nLocal[1]};
+    const std::array<double, 3> h2{discretization_->dx2(), discretization_->dy2(), discretization_->dz2()};
+    const int nCellsLocal = pi.totalNoOfCellsLocal();
+
+    std::size_t maxLineCells = 0;
+    for(int d = 0; d < 3; d++)
+    {
+        Pencil &pencil = pencils_[d];
+        const int d1 = (d == 0) ? 1 : 0;
+        const int d2 = (d == 2) ? 1 : 2;
+
+        // the offsets are unique for each partition coordinate and ordered along the direction
+        const int color = offset[d1] * (nGlobal[d2] + 1) + offset[d2];
+        MPI_Comm_split(pi.comm(), color, offset[d], &pencil.comm);
+        MPI_Comm_size(pencil.comm, &pencil.nRanks);
+        MPI_Comm_rank(pencil.comm, &pencil.position);
+        const int position = pencil.position;
+
+        pencil.stride = strides[d];
+        pencil.otherStrides = {strides[d1], strides[d2]};
+        pencil.otherLengths = {nLocal[d1], nLocal[d2]};
+
+        pencil.segmentLengths.resize(pencil.nRanks);
+        pencil.segmentOffsets.resize(pencil.nRanks);
+        MPI_Allgather(&nLocal[d], 1, MPI_INT, pencil.segmentLengths.data(), 1, MPI_INT, pencil.comm);
+        pencil.lineLength = 0;
+        for(int r = 0; r < pencil.nRanks; r++)
+        {
+            pencil.segmentOffsets[r] = pencil.lineLength;
+            pencil.lineLength += pencil.segmentLengths[r];
+        }
+        if(pencil.lineLength != nGlobal[d] || pencil.segmentOffsets[position] != offset[d])
+        {
+            std::stringstream str;
+            str << "The partitions of rank " << pi.ownRankNo() << " do not form complete lines in direction " << d
+                << ", got " << pencil.lineLength << " instead of " << nGlobal[d] << " cells!\n";
+            throw std::runtime_error(str.str());
+        }
+
+        // all ranks of the pencil have the same lines, they are distributed equally
+        const int nLinesLocal = nLocal[d1] * nLocal[d2];
+        pencil.firstLines.resize(pencil.nRanks);
+        pencil.nLines.resize(pencil.nRanks);
+        for(int q = 0; q < pencil.nRanks; q++)
+        {
+            pencil.firstLines[q] = (nLinesLocal * q) / pencil.nRanks;
+            pencil.nLines[q] = (nLinesLocal * (q+1)) / pencil.nRanks - pencil.firstLines[q];
+        }
+
+        pencil.blockCounts.resize(pencil.nRanks);
+        pencil.blockDispls.resize(pencil.nRanks);
+        pencil.lineCounts.resize(pencil.nRanks);
+        pencil.lineDispls.resize(pencil.nRanks);
+        int blockDispl = 0;
+        int lineDispl = 0;
+        for(int r = 0; r < pencil.nRanks; r++)
+        {
+            // the own segment of the lines of rank r and the segments of rank r of the own lines
+            pencil.blockCounts[r] = pencil.nLines[r] * nLocal[d];
+            pencil.blockDispls[r] = blockDispl;
+            blockDispl += pencil.blockCounts[r];
+            pencil.lineCounts[r] = pencil.nLines[position] * pencil.segmentLengths[r];
+            pencil.lineDispls[r] = lineDispl;
+            lineDispl += pencil.lineCounts[r];
+        }
+        maxLineCells = std::max(maxLineCells, (std::size_t)lineDispl);
+
+        pencil.dct = std::make_shared<DCT>(nGlobal[d]);
+
+        // eigenvalue of the cosine mode with global wave number kk
+        eigenvalues_[d].resize(nLocal[d]);
+        for(int t = 0; t < nLocal[d]; t++)
+        {
+            const double s = std::sin(M_PI * (offset[d] + t) / (2. * nGlobal[d]));
+            eigenvalues_[d][t] = -4. * s * s / h2[d];
+        }
+    }
+
+    buffer_.resize(nCellsLocal);
+    sendBuffer_.resize(nCellsLocal);
+    lines_.resize(maxLineCells);
+    recvBuffer_.resize(maxLineCells);
+}
+
+FFTPoisson::~FFTPoisson()
+{
+    int finalized;
+    MPI_Finalized(&finalized);
+    if(finalized)
+        return;
+    for(Pencil &pencil : pencils_)
+        MPI_Comm_free(&pencil.comm);
+}
+
+void FFTPoisson::step()
+{
+    const int iN = discretization_->piN();
+    const int jN = discretization_->pjN();
+    const int kN = discretization_->pkN();
+    const Array3DView p = discretization_->pView(), b = discretization_->rhsView();
+
+    for(int k = 0; k < kN; k++)
+        for(int j = 0; j < jN; j++)
+            for(int i = 0; i < iN; i++)
+                buffer_[i + iN*(j + jN*k)] = b(i,j,k);
+
+    for(int d = 0; d < 3; d++)
+        transform(d, true);
+
+    // the constant mode has the eigenvalue 0, it is the free constant of the Neumann problem
+    for(int k = 0; k < kN; k++)
+    {
+        for(int j = 0; j < jN; j++)
+        {
+            for(int i = 0; i < iN; i++)
+            {
+                const double eigenvalue = eigenvalues_[0][i] + eigenvalues_[1][j] + eigenvalues_[2][k];
+                double &mode = buffer_[i + iN*(j + jN*k)];
+                mode = (eigenvalue == 0.0) ? 0.0 : mode / eigenvalue;
+            }
+        }
+    }
+
+    for(int d = 0; d < 3; d++)
+        transform(d, false);
+
+    for(int k = 0; k < kN; k++)
+        for(int j = 0; j < jN; j++)
+            for(int i = 0; i < iN; i++)
+                p(i,j,k) = buffer_[i + iN*(j + jN*k)];
+
+    partition_->setBoundaryP();
+}
+
+void FFTPoisson::transform(int d, bool forward)
+{
+    Pencil &pencil = pencils_[d];
+    const int segmentLength = pencil.segmentLengths[pencil.position];
+    const int nOwnLines = pencil.nLines[pencil.position];
+
+    // send the own segments of the lines to the ranks transforming them
+    int s = 0;
+    for(int q = 0; q < pencil.nRanks; q++)
+    {
+        for(int l = pencil.firstLines[q]; l < pencil.firstLines[q] + pencil.nLines[q]; l++)
+        {
+            const int begin = lineBegin(pencil, l);
+            for(int t = 0; t < segmentLength; t++)
+                sendBuffer_[s++] = buffer_[begin + t*pencil.stride];
+        }
+    }
+    MPI_Alltoallv(sendBuffer_.data(), pencil.blockCounts.data(), pencil.blockDispls.data(), MPI_DOUBLE,
+                  recvBuffer_.data(), pencil.lineCounts.data(), pencil.lineDispls.data(), MPI_DOUBLE, pencil.comm);
+
+    for(int r = 0; r < pencil.nRanks; r++)
+        for(int l = 0; l < nOwnLines; l++)
+            for(int t = 0; t < pencil.segmentLengths[r]; t++)
+                lines_[l*pencil.lineLength + pencil.segmentOffsets[r] + t] =
+                    recvBuffer_[pencil.lineDispls[r] + l*pencil.segmentLengths[r] + t];
+
+    for(int l = 0; l < nOwnLines; l++)
+    {
+        if(forward)
+            pencil.dct->forward(&lines_[l*pencil.lineLength]);
+        else
+            pencil.dct->backward(&lines_[l*pencil.lineLength]);
+    }
+
+    // and the same way back
+    for(int r = 0; r < pencil.nRanks; r++)
+        for(int l = 0; l < nOwnLines; l++)
+            for(int t = 0; t < pencil.segmentLengths[r]; t++)
+                recvBuffer_[pencil.lineDispls[r] + l*pencil.segmentLengths[r] + t] =
+                    lines_[l*pencil.lineLength + pencil.segmentOffsets[r] + t];
+    MPI_Alltoallv(recvBuffer_.data(), pencil.lineCounts.data(), pencil.lineDispls.data(), MPI_DOUBLE,
+                  sendBuffer_.data(), pencil.blockCounts.data(), pencil.blockDispls.data(), MPI_DOUBLE, pencil.comm);
+
+    s = 0;
+    for(int q = 0; q < pencil.nRanks; q++)
+    {
+        for(int l = pencil.firstLines[q]; l < pencil.firstLines[q] + pencil.nLines[q]; l++)
+        {
+            const int begin = lineBegin(pencil, l);
+            for(int t = 0; t < segmentLength; t++)
+                buffer_[begin + t*pencil.stride] = sendBuffer_[s++];
+        }
+    }
+}
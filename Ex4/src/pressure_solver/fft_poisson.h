@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <sstream>
+#include <mpi.h>
+#include "pressure_solver/pressure_solver.h"
+#include "pressure_solver/dct.h"
+#include "discretization/discretization.h"
+#include "discretization/partition_shell.h"
+#include "discretization/partition_information.h"
+
+//! Direct pressure solver for the uniform box with homogeneous Neumann walls, i.e. the pressure boundary
+//! of the Dirichlet velocity boundaries. The cosine transforms diagonalize the discrete laplacian,
+//! so one step transforms the rhs in all 3 directions, divides it by the eigenvalues and transforms it back in O(N log N).
+//! Each direction is transformed on complete lines, which are distributed over the ranks sharing
+//! the other two partition coordinates (pencil transpose with MPI_Alltoallv) and sent back afterwards.
+//! The constant pressure mode is set to 0, the velocities only see the pressure gradient.
+class FFTPoisson : public PressureSolver
+{
+public:
+    //! same as the pressure-solver constructor, it sets up the transforms and line communicators of all 3 directions
+    FFTPoisson(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations);
+
+    ~FFTPoisson();
+
+    //! one direct solve, which sets the ghost layers of p, so the following residuum check is exact
+    void step() override;
+
+protected:
+    //! communication pattern to transform along one direction
+    struct Pencil
+    {
+        //! ranks, which share the other two partition coordinates, ordered along the direction
+        MPI_Comm comm;
+        int nRanks;
+        //! own rank within comm
+        int position;
+        //! global number of cells in the direction, the length of each line
+        int lineLength;
+        //! stride of the direction and the other two directions in the local block
+        int stride;
+        std::array<int, 2> otherStrides;
+        std::array<int, 2> otherLengths;
+        //! cells of each rank in the direction and their offset within the line
+        std::vector<int> segmentLengths;
+        std::vector<int> segmentOffsets;
+        //! the local lines are distributed equally over the ranks of the pencil, this rank transforms [firstLine, firstLine+nLines)
+        std::vector<int> firstLines;
+        std::vector<int> nLines;
+        //! counts and displacements of the MPI_Alltoallv from the block into the lines
+        std::vector<int> blockCounts, blockDispls;
+        std::vector<int> lineCounts, lineDispls;
+        std::shared_ptr<DCT> dct;
+    };
+
+    //! transforms the local block in buffer_ along direction d
+    void transform(int d, bool forward);
+
+    //! start index of line l in the local block
+    inline int lineBegin(const Pencil &pencil, int l) const
+    {
+        return (l % pencil.otherLengths[0]) * pencil.otherStrides[0] + (l / pencil.otherLengths[0]) * pencil.otherStrides[1];
+    }
+
+    std::array<Pencil, 3> pencils_;
+
+    //! local block of rhs and p in the order i, j, k without ghost layers
+    std::vector<double> buffer_;
+    //! the lines transformed by this rank and the send/receive buffers to exchange them
+    std::vector<double> lines_;
+    std::vector<double> sendBuffer_;
+    std::vector<double> recvBuffer_;
+
+    //! eigenvalues of the 1D laplacians for the local wave numbers of each direction
+    std::array<std::vector<double>, 3> eigenvalues_;
+};
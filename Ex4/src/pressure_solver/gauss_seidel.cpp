@@ -1,12 +1,24 @@
 #include "pressure_solver/gauss_seidel.h"
 
+GaussSeidel::GaussSeidel(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations) :
+                         PressureSolver(partition, epsilon, maximumNumberOfIterations),
+                         correctionPlane_({discretization_->piN()+1, discretization_->pjN()+1}, "gaussSeidel.correctionPlane")
+{
+    providesSweepResiduum_ = true;
+}
+
 inline void GaussSeidel::step()
 {
     const double dx2 = discretization_->dx2();
     const double dy2 = discretization_->dy2();
     const double dz2 = discretization_->dz2();
     const double factor = (dx2 * dy2 * dz2) / (2. * (dy2*dz2+dx2*dz2+dx2*dy2));
+    const Array3DView p = discretization_->pView(), b = discretization_->rhsView();
 
+    // The correction is the residuum scaled by -factor, but the lower neighbours were already updated.
+    // Adding their change back recovers the residuum of the iterate the sweep started from for free.
+    std::fill(correctionPlane_.data(), correctionPlane_.data() + correctionPlane_.length(), 0.0);
+    double residuum2 = 0.0;
     // algorithm updates all cells in place, as described in the lecture
     for(int k = 0; k<discretization_->pkN(); k++) 
     {
@@ -15,17 +27,24 @@ inline void GaussSeidel::step()
             for(int i = 0; i < discretization_->piN(); i++)
             {   
                 // store all variables with short name for readibilty
-                const double p_xm   = discretization_->p(i-1,j,k);
-                const double p_xp   = discretization_->p(i+1,j,k);
-                const double p_ym   = discretization_->p(i,j-1,k);
-                const double p_yp   = discretization_->p(i,j+1,k);
-                const double p_zm   = discretization_->p(i,j,k-1);
-                const double p_zp   = discretization_->p(i,j,k+1);
-                const double rhs    = discretization_->rhs(i,j,k);
+                const double p_last = p(i,j,k);
+                const double p_xm   = p(i-1,j,k);
+                const double p_xp   = p(i+1,j,k);
+                const double p_ym   = p(i,j-1,k);
+                const double p_yp   = p(i,j+1,k);
+                const double p_zm   = p(i,j,k-1);
+                const double p_zp   = p(i,j,k+1);
+                const double rhs    = b(i,j,k);
                 
                 double p_new = factor * ((p_xm+p_xp)/dx2 + (p_ym+p_yp)/dy2 + (p_zm+p_zp)/dz2 - rhs);
-                discretization_->p(i, j, k) = p_new;
+                p(i,j,k) = p_new;
+
+                const double res_last = (p_last - p_new) / factor + correctionPlane_(i,j+1) / dx2 
+                                      + correctionPlane_(i+1,j) / dy2 + correctionPlane_(i+1,j+1) / dz2;
+                correctionPlane_(i+1,j+1) = p_new - p_last;
+                residuum2 += res_last * res_last;
             }
         }
     }
+    sweepResiduum2_ = residuum2;
 }
\ No newline at end of file
@@ -2,14 +2,21 @@
 
 #include <memory>
 #include <cmath>
+#include <algorithm>
 #include <mpi.h>
 #include "pressure_solver/pressure_solver.h"
 #include "discretization/discretization.h"
 #include "storage/field_variable.h"
+#include "storage/array2D.h"
 
 class GaussSeidel : public PressureSolver {
 public:
-    //! Use the standard pressure-solver constructor
-    using PressureSolver::PressureSolver;
+    //! Same as the standard pressure-solver constructor, the sweep provides its residuum
+    GaussSeidel(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations);
     void step() override;
+
+protected:
+    //! change of the cells in the last plane, used to recover the residuum of the iterate before the sweep,
+    //! shifted by one, so the ghost cells are 0
+    Array2D correctionPlane_;
 };
\ No newline at end of file
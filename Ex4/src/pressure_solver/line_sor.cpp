@@ -0,0 +1,231 @@
+#include "pressure_solver/line_sor.h"
+
+LineSOR::LineSOR(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations, double omega,
+                 int lineDirection) :
+                 PressureSolver(partition, epsilon, maximumNumberOfIterations),
+                 omega_(omega), d_(lineDirection < 0 ? stiffDirection(partition->pi_) : lineDirection),
+                 e1_(d_ == 0 ? 1 : 0), e2_(d_ == 2 ? 1 : 2), n_(partition->pi_.nCellsLocal()),
+                 parityOffset_((partition->pi_.nodeOffset()[e1_] + partition->pi_.nodeOffset()[e2_]) & 0b1)
+{
+    if(omega <= 0.0 || omega >= 2.0)
+    {
+        std::stringstream str;
+        str << "Omega may only be 0.0 < "  << omega << " < 2.0!\n";
+        throw std::out_of_range(str.str());
+    }
+    if(d_ > 2)
+    {
+        std::stringstream str;
+        str << "The line direction has to be 0, 1, 2 or -1 (automatic), but is " << lineDirection << "!\n";
+        throw std::out_of_range(str.str());
+    }
+    // the reduction to the first and last cell needs one cell in between
+    int minimumLength = n_[d_];
+    MPI_Allreduce(MPI_IN_PLACE, &minimumLength, 1, MPI_INT, MPI_MIN, partition_->pi_.comm());
+    if(minimumLength < 3)
+    {
+        std::stringstream str;
+        str << "The line solver needs at least 3 cells per partition in direction " << d_ << ", but got " << minimumLength << "!\n";
+        throw std::runtime_error(str.str());
+    }
+
+    const PartitionInformation &pi = partition_->pi_;
+    const std::array<int, 3> offset = pi.nodeOffset();
+    const std::array<int, 3> nGlobal = pi.nCellsGlobal();
+    const int color = offset[e1_] * (nGlobal[e2_] + 1) + offset[e2_];
+    MPI_Comm_split(pi.comm(), color, offset[d_], &lineComm_);
+    MPI_Comm_size(lineComm_, &nLineRanks_);
+    MPI_Comm_rank(lineComm_, &linePosition_);
+
+    // the line equation a x_{t-1} + b x_t + c x_{t+1} = rhs - (neighbours in the other directions),
+    // at the walls the Neumann ghost cell is the cell itself
+    const std::array<double, 3> h2{discretization_->dx2(), discretization_->dy2(), discretization_->dz2()};
+    const std::array<bool, 3> lowerWall{pi.ownLeftBoundary(), pi.ownBottomBoundary(), pi.ownHindBoundary()};
+    const std::array<bool, 3> upperWall{pi.ownRightBoundary(), pi.ownTopBoundary(), pi.ownFrontBoundary()};
+    const int m = n_[d_];
+    a_.assign(m, 1. / h2[d_]);
+    std::vector<double> b(m, -2. * (1. / h2[0] + 1. / h2[1] + 1. / h2[2]));
+    std::vector<double> c(m, 1. / h2[d_]);
+    if(lowerWall[d_])
+    {
+        b[0] += a_[0];
+        a_[0] = 0.0;
+    }
+    if(upperWall[d_])
+    {
+        b[m-1] += c[m-1];
+        c[m-1] = 0.0;
+    }
+
+    // forward elimination, which keeps the coupling of each row to the first cell (PaScaL_TDMA)
+    rf_.resize(m);
+    cf_.resize(m);
+    std::vector<double> af(m);
+    for(int t = 0; t < m; t++)
+    {
+        rf_[t] = (t < 2) ? 1. / b[t] : 1. / (b[t] - a_[t] * cf_[t-1]);
+        cf_[t] = rf_[t] * c[t];
+        af[t] = (t < 2) ? rf_[t] * a_[t] : -rf_[t] * a_[t] * af[t-1];
+    }
+    // backward elimination, which keeps the coupling to the last cell
+    A_ = af;
+    C_ = cf_;
+    for(int t = m-3; t >= 1; t--)
+    {
+        A_[t] = af[t] - cf_[t] * A_[t+1];
+        C_[t] = -cf_[t] * C_[t+1];
+    }
+    r0_ = 1. / (1. - cf_[0] * A_[1]);
+    A_[0] = r0_ * af[0];
+    C_[0] = -r0_ * cf_[0] * C_[1];
+
+    // the rows of the first and last cells of all segments form a tridiagonal system
+    const double reducedRows[4] = {A_[0], C_[0], A_[m-1], C_[m-1]};
+    std::vector<double> allReducedRows(4 * nLineRanks_);
+    MPI_Allgather(reducedRows, 4, MPI_DOUBLE, allReducedRows.data(), 4, MPI_DOUBLE, lineComm_);
+    const int nReduced = 2 * nLineRanks_;
+    reducedLower_.resize(nReduced);
+    reducedUpper_.resize(nReduced);
+    reducedInverse_.resize(nReduced);
+    for(int r = 0; r < nReduced; r++)
+    {
+        const double lower = allReducedRows[2*r];
+        const double upper = allReducedRows[2*r+1];
+        const double pivot = (r == 0) ? 1.0 : 1. - lower * reducedUpper_[r-1];
+        reducedLower_[r] = lower;
+        reducedInverse_[r] = 1. / pivot;
+        reducedUpper_[r] = upper / pivot;
+    }
+
+    laneStride_ = (n_[e1_] + 1) / 2;
+    nSlots_ = laneStride_ * n_[e2_];
+    work_.assign(m * nSlots_, 0.0);
+    reducedSend_.resize(2 * nSlots_);
+    reducedRecv_.resize(nReduced * nSlots_);
+}
+
+LineSOR::~LineSOR()
+{
+    int finalized;
+    MPI_Finalized(&finalized);
+    if(!finalized)
+        MPI_Comm_free(&lineComm_);
+}
+
+int LineSOR::stiffDirection(const PartitionInformation &pi)
+{
+    const std::array<double, 3> meshWidth = pi.meshWidth();
+    return std::min_element(meshWidth.begin(), meshWidth.end()) - meshWidth.begin();
+}
+
+void LineSOR::step()
+{
+    relaxLines(0);
+    partition_->setBoundaryP();
+    relaxLines(1);
+}
+
+void LineSOR::relaxLines(int colour)
+{
+    const std::array<double, 3> h2{discretization_->dx2(), discretization_->dy2(), discretization_->dz2()};
+    FieldVariable &p = discretization_->p();
+    FieldVariable &rhs = discretization_->rhs();
+    const std::array<std::size_t, 3> pStride{1, (std::size_t)p.size()[0], (std::size_t)p.size()[0] * p.size()[1]};
+    const std::array<std::size_t, 3> rhsStride{1, (std::size_t)rhs.size()[0], (std::size_t)rhs.size()[0] * rhs.size()[1]};
+    const int m = n_[d_];
+    double *pData = p.data();
+    const double *rhsData = rhs.data();
+    double *work = work_.data();
+
+    // rhs of the lines, the neighbours in the other directions are all of the other colour
+    for(int b = 0; b < n_[e2_]; b++)
+    {
+        for(int lane = 0, a = firstLine(b, colour); a < n_[e1_]; lane++, a += 2)
+        {
+            const int slot = b * laneStride_ + lane;
+            const std::size_t pLine = pStride[d_] + (a+1) * pStride[e1_] + (b+1) * pStride[e2_];
+            const std::size_t rhsLine = a * rhsStride[e1_] + b * rhsStride[e2_];
+            for(int t = 0; t < m; t++)
+            {
+                const std::size_t cell = pLine + t * pStride[d_];
+                work[t * nSlots_ + slot] = rhsData[rhsLine + t * rhsStride[d_]]
+                                         - (pData[cell - pStride[e1_]] + pData[cell + pStride[e1_]]) / h2[e1_]
+                                         - (pData[cell - pStride[e2_]] + pData[cell + pStride[e2_]]) / h2[e2_];
+            }
+        }
+    }
+
+    // the same elimination as for the coefficients, for all lines at once
+    for(int t = 0; t < m; t++)
+    {
+        double *row = work + t * nSlots_;
+        const double *previous = row - nSlots_;
+        if(t < 2)
+            for(int s = 0; s < nSlots_; s++)
+                row[s] *= rf_[t];
+        else
+            for(int s = 0; s < nSlots_; s++)
+                row[s] = rf_[t] * (row[s] - a_[t] * previous[s]);
+    }
+    for(int t = m-3; t >= 1; t--)
+    {
+        double *row = work + t * nSlots_;
+        const double *next = row + nSlots_;
+        for(int s = 0; s < nSlots_; s++)
+            row[s] -= cf_[t] * next[s];
+    }
+    for(int s = 0; s < nSlots_; s++)
+        work[s] = r0_ * (work[s] - cf_[0] * work[nSlots_ + s]);
+
+    // reduced system of the first and last cells of all segments
+    std::copy(work, work + nSlots_, reducedSend_.begin());
+    std::copy(work + (m-1) * nSlots_, work + m * nSlots_, reducedSend_.begin() + nSlots_);
+    MPI_Allgather(reducedSend_.data(), 2 * nSlots_, MPI_DOUBLE, reducedRecv_.data(), 2 * nSlots_, MPI_DOUBLE, lineComm_);
+    const int nReduced = 2 * nLineRanks_;
+    double *reduced = reducedRecv_.data();
+    for(int r = 0; r < nReduced; r++)
+    {
+        double *row = reduced + r * nSlots_;
+        const double *previous = row - nSlots_;
+        if(r == 0)
+            continue;
+        for(int s = 0; s < nSlots_; s++)
+            row[s] = (row[s] - reducedLower_[r] * previous[s]) * reducedInverse_[r];
+    }
+    for(int r = nReduced-2; r >= 0; r--)
+    {
+        double *row = reduced + r * nSlots_;
+        const double *next = row + nSlots_;
+        for(int s = 0; s < nSlots_; s++)
+            row[s] -= reducedUpper_[r] * next[s];
+    }
+
+    // the segment follows from its first and last cell
+    const double *first = reduced + 2 * linePosition_ * nSlots_;
+    const double *last = first + nSlots_;
+    for(int t = 0; t < m; t++)
+    {
+        double *row = work + t * nSlots_;
+        if(t == 0)
+            std::copy(first, first + nSlots_, row);
+        else if(t == m-1)
+            std::copy(last, last + nSlots_, row);
+        else
+            for(int s = 0; s < nSlots_; s++)
+                row[s] -= A_[t] * first[s] + C_[t] * last[s];
+    }
+
+    for(int b = 0; b < n_[e2_]; b++)
+    {
+        for(int lane = 0, a = firstLine(b, colour); a < n_[e1_]; lane++, a += 2)
+        {
+            const int slot = b * laneStride_ + lane;
+            const std::size_t pLine = pStride[d_] + (a+1) * pStride[e1_] + (b+1) * pStride[e2_];
+            for(int t = 0; t < m; t++)
+            {
+                double &cell = pData[pLine + t * pStride[d_]];
+                cell += omega_ * (work[t * nSlots_ + slot] - cell);
+            }
+        }
+    }
+}
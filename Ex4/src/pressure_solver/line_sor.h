@@ -0,0 +1,78 @@
+#pragma once
+
+#include <memory>
+#include <array>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <exception>
+#include <sstream>
+#include <mpi.h>
+#include "pressure_solver/pressure_solver.h"
+#include "discretization/discretization.h"
+#include "discretization/partition_shell.h"
+#include "discretization/partition_information.h"
+#include "storage/field_variable.h"
+
+//! Zebra line SOR for anisotropic meshes: the cells of each line along the stiff direction are solved at once,
+//! the other two directions are relaxed in a red-black order of the lines, so all lines of a colour are independent.
+//! The tridiagonal systems share their coefficients, only the rhs differs, so the Thomas recurrences are precomputed
+//! and applied to all lines of a colour at once, with the lines as the contiguous (vectorized) index.
+//! Lines crossing partitions are solved with the partition method of PaScaL_TDMA (Kim et al., 2021): each rank
+//! reduces its segment to its first and last cell, the reduced systems of all lines are gathered over the ranks
+//! sharing the line and each rank solves the 2*nRanks system of its lines, so one collective is needed per colour.
+class LineSOR : public PressureSolver
+{
+public:
+    //! lineDirection 0, 1 or 2, -1 chooses the direction with the smallest mesh width, i.e. the strongest coupling
+    LineSOR(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations, double omega,
+            int lineDirection = -1);
+
+    ~LineSOR();
+
+    //! direction with the smallest mesh width
+    static int stiffDirection(const PartitionInformation &pi);
+
+    //! relaxes the lines of both colours, the halo is set in between
+    void step() override;
+
+protected:
+    //! solves all lines of one colour and relaxes p towards their solution
+    void relaxLines(int colour);
+
+    //! index of the first line of the colour in the row b of lines
+    inline int firstLine(int b, int colour) const { return (b + parityOffset_ + colour) & 0b1; }
+
+    const double omega_;
+    //! line direction and the two other directions
+    const int d_, e1_, e2_;
+    //! local number of cells in all 3 directions
+    const std::array<int, 3> n_;
+    //! parity of the global index of the first line of the partition
+    const int parityOffset_;
+
+    //! ranks sharing the lines of this partition, ordered along them
+    MPI_Comm lineComm_;
+    int nLineRanks_;
+    int linePosition_;
+
+    //! coefficients of the line equations, the same for all lines of the partition
+    std::vector<double> a_;
+    //! inverse pivots and upper coefficients of the forward elimination
+    std::vector<double> rf_, cf_;
+    //! after the elimination the cell t is d'_t - A_t x_0 - C_t x_{n-1}, for t=0 (t=n-1) A (C) belongs to the neighbour
+    std::vector<double> A_, C_;
+    //! elimination of the first row with the second one
+    double r0_;
+    //! Thomas factors of the reduced system, which has 2 rows per rank
+    std::vector<double> reducedLower_, reducedUpper_, reducedInverse_;
+
+    //! number of line slots of a colour, the lines of one row b are stored at b*laneStride_ + lane
+    int laneStride_;
+    int nSlots_;
+    //! rhs and solution of the lines of a colour, the slots are the contiguous index
+    std::vector<double> work_;
+    //! first and last cell of the own segment of each line and the ones of all ranks
+    std::vector<double> reducedSend_;
+    std::vector<double> reducedRecv_;
+};
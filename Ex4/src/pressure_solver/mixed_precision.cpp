@@ -0,0 +1,123 @@
+#include "pressure_solver/mixed_precision.h"
+
+MixedPrecision::MixedPrecision(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations,
+                               double omega, int innerIterations, MixedPrecisionSmoother smoother) :
+                               PressureSolver(partition, epsilon, maximumNumberOfIterations),
+                               omega_(omega), innerIterations_(innerIterations), smoother_(smoother),
+                               invDx2_(1. / discretization_->dx2()),
+                               invDy2_(1. / discretization_->dy2()),
+                               invDz2_(1. / discretization_->dz2()),
+                               factor_(1. / (2. * (1. / discretization_->dx2() + 1. / discretization_->dy2() + 1. / discretization_->dz2()))),
+                               residuum_(discretization_->p().size(), "mixedPrecision.residuum"),
+                               correction_(discretization_->p().size(), "mixedPrecision.correction")
+{
+    if(omega <= 0.0 || omega >= 2.0)
+    {
+        std::stringstream str;
+        str << "Omega may only be 0.0 < "  << omega << " < 2.0!\n";
+        throw std::out_of_range(str.str());
+    }
+    if(innerIterations < 1)
+    {
+        std::stringstream str;
+        str << "The mixed precision solver requires at least 1 inner iteration, but got " << innerIterations << "!\n";
+        throw std::out_of_range(str.str());
+    }
+    // the residuum of the iterate the step started from is calculated anyway
+    providesSweepResiduum_ = true;
+}
+
+void MixedPrecision::step()
+{
+    // the residuum is calculated in double, only the correction equation is relaxed in float,
+    // the fields are indexed including their ghost layer, so the partition starts at 1
+    const double dx2 = discretization_->dx2();
+    const double dy2 = discretization_->dy2();
+    const double dz2 = discretization_->dz2();
+    const Array3DView p = discretization_->pView(), b = discretization_->rhsView();
+    const FloatArray3DView residuum = residuum_.view(), correction = correction_.view();
+    double residuum2 = 0.0;
+    for(int k = 0; k < discretization_->pkN(); k++)
+    {
+        for(int j = 0; j < discretization_->pjN(); j++)
+        {
+            for(int i = 0; i < discretization_->piN(); i++)
+            {
+                const double D2pDx2 = (p(i+1,j,k) - 2.*p(i,j,k) + p(i-1,j,k)) / dx2;
+                const double D2pDy2 = (p(i,j+1,k) - 2.*p(i,j,k) + p(i,j-1,k)) / dy2;
+                const double D2pDz2 = (p(i,j,k+1) - 2.*p(i,j,k) + p(i,j,k-1)) / dz2;
+                const double r = b(i,j,k) - (D2pDx2 + D2pDy2 + D2pDz2);
+                residuum(i+1,j+1,k+1) = r;
+                residuum2 += r * r;
+            }
+        }
+    }
+    sweepResiduum2_ = residuum2;
+
+    correction_.setToZero();
+    for(int n = 0; n < innerIterations_; n++)
+    {
+        if(smoother_ == MixedPrecisionSmoother::SOR)
+            sweepSOR();
+        else
+            sweepCheckerboard();
+    }
+
+    for(int k = 0; k < discretization_->pkN(); k++)
+        for(int j = 0; j < discretization_->pjN(); j++)
+            for(int i = 0; i < discretization_->piN(); i++)
+                p(i,j,k) += correction(i+1,j+1,k+1);
+
+    partition_->setBoundaryP();
+}
+
+void MixedPrecision::sweepSOR()
+{
+    partition_->setBoundaryCellField(correction_);
+    const FloatArray3DView e = correction_.view(), residuum = residuum_.view();
+    for(int k = 1; k <= discretization_->pkN(); k++)
+    {
+        for(int j = 1; j <= discretization_->pjN(); j++)
+        {
+            for(int i = 1; i <= discretization_->piN(); i++)
+            {
+                const float e_last = e(i,j,k);
+                const float e_correction = factor_ * ((e(i-1,j,k) + e(i+1,j,k)) * invDx2_
+                                                    + (e(i,j-1,k) + e(i,j+1,k)) * invDy2_
+                                                    + (e(i,j,k-1) + e(i,j,k+1)) * invDz2_
+                                                    - residuum(i,j,k)) - e_last;
+                e(i,j,k) = e_last + omega_ * e_correction;
+            }
+        }
+    }
+}
+
+void MixedPrecision::sweepCheckerboard()
+{
+    partition_->setBoundaryCellField(correction_);
+    relaxColour(0);
+    partition_->exchangeCellField(correction_);
+    relaxColour(1);
+}
+
+void MixedPrecision::relaxColour(int colour)
+{
+    const FloatArray3DView e = correction_.view(), residuum = residuum_.view();
+    for(int k = 1; k <= discretization_->pkN(); k++)
+    {
+        for(int j = 1; j <= discretization_->pjN(); j++)
+        {
+            // same colouring as Checkerboard, which starts with the cell (0,0,0) without ghost layers
+            const int offset = 1 + (((k-1) & 0b1) ^ ((j-1) & 0b1) ^ colour);
+            for(int i = offset; i <= discretization_->piN(); i += 2)
+            {
+                const float e_last = e(i,j,k);
+                const float e_correction = factor_ * ((e(i-1,j,k) + e(i+1,j,k)) * invDx2_
+                                                    + (e(i,j-1,k) + e(i,j+1,k)) * invDy2_
+                                                    + (e(i,j,k-1) + e(i,j,k+1)) * invDz2_
+                                                    - residuum(i,j,k)) - e_last;
+                e(i,j,k) = e_last + omega_ * e_correction;
+            }
+        }
+    }
+}
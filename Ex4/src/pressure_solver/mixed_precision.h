@@ -0,0 +1,58 @@
+#pragma once
+
+#include <memory>
+#include <cmath>
+#include <exception>
+#include <sstream>
+#include <mpi.h>
+#include "pressure_solver/pressure_solver.h"
+#include "discretization/discretization.h"
+#include "discretization/partition_shell.h"
+#include "storage/field_variable.h"
+#include "storage/float_array3D.h"
+
+//! Relaxation of the mixed precision solver
+enum class MixedPrecisionSmoother : char
+{
+    SOR          = 'S',
+    Checkerboard = 'C'
+};
+
+//! Iterative refinement with single precision relaxation sweeps.
+//! Each step calculates the residuum of p in double precision, relaxes the correction equation Δe = r
+//! with innerIterations SOR or Checkerboard sweeps on float fields and adds the correction to p.
+//! The sweeps move half the bytes of the double solvers and their halos are sent as float,
+//! the double residuum of the outer iteration keeps the full accuracy of the solution.
+class MixedPrecision : public PressureSolver
+{
+public:
+    MixedPrecision(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations,
+                   double omega, int innerIterations, MixedPrecisionSmoother smoother);
+
+    //! one refinement step, which sets the ghost layers of p, so the following residuum check is exact
+    void step() override;
+
+protected:
+    //! one lexicographic sweep over the correction
+    void sweepSOR();
+
+    //! red and black half sweep with a single precision halo exchange in between
+    void sweepCheckerboard();
+
+    //! relaxes the cells with (i+j+k)%2 == colour, the colour is local to the partition like in Checkerboard
+    void relaxColour(int colour);
+
+    const float omega_;
+    const int innerIterations_;
+    const MixedPrecisionSmoother smoother_;
+
+    //! coefficients of the relaxation in single precision
+    const float invDx2_;
+    const float invDy2_;
+    const float invDz2_;
+    const float factor_;
+
+    //! residuum of p, the rhs of the correction equation, and the correction itself, both with the layout of p
+    FloatArray3D residuum_;
+    FloatArray3D correction_;
+};
@@ -0,0 +1,251 @@
+#include "pressure_solver/multigrid.h"
+
+Multigrid::Multigrid(std::shared_ptr<PartitionShell> partition, const Settings &settings) :
+                     PressureSolver(partition, settings.epsilon, settings.maximumNumberOfIterations),
+                     smoothingSteps_(settings.multigridSmoothingSteps),
+                     coarseIterations_(settings.multigridCoarseIterations)
+{
+    if(settings.multigridMaxLevels < 1 || smoothingSteps_ < 1 || coarseIterations_ < 1)
+    {
+        std::stringstream str;
+        str << "Multigrid requires at least one level (" << settings.multigridMaxLevels << "), one smoothing step ("
+            << smoothingSteps_ << ") and one coarse iteration (" << coarseIterations_ << ")!\n";
+        throw std::out_of_range(str.str());
+    }
+
+    // red-black Gauss-Seidel (omega = 1) has the best smoothing properties, over-relaxation
+    // would only amplify the high frequencies, which the coarse grids can not see
+    Level finest;
+    finest.discretization = discretization_;
+    finest.partition = partition_;
+    levels_.push_back(finest);
+
+    while((int)levels_.size() < settings.multigridMaxLevels)
+    {
+        const PartitionInformation &finePi = levels_.back().partition->pi_;
+
+        // solving the coarse grid directly is cheaper than coarsening it further,
+        // the finest grid is always smoothed, as it is not necessarily solved by p and rhs
+        if(levels_.size() > 1 && finePi.totalNoOfCellsGlobal() <= agglomerationCells)
+            break;
+
+        // the coarse cells have to align with the partition borders on every rank,
+        // so it is only coarsened further, if all ranks keep at least one cell in each direction
+        int coarsenable = 1;
+        for(int d = 0; d < 3; d++)
+        {
+            if(finePi.nCellsLocal()[d] < 2)
+                coarsenable = 0;
+        }
+        int allCoarsenable;
+        MPI_Allreduce(&coarsenable, &allCoarsenable, 1, MPI_INT, MPI_MIN, finePi.comm());
+        if(!allCoarsenable)
+            break;
+
+        // the coarse levels only use p and rhs, the cheapest discretization is sufficient
+        Level coarse;
+        coarse.pi = std::make_shared<PartitionInformation>(finePi, 2);
+        coarse.discretization = std::make_shared<CentralDifferences>(*coarse.pi, settings);
+        coarse.partition = std::make_shared<AsyncPartition>(coarse.discretization, settings, *coarse.pi);
+        levels_.push_back(coarse);
+    }
+
+    for(Level &level : levels_)
+    {
+        const std::array<int, 3> offset = level.partition->pi_.nodeOffset();
+        level.x = &level.discretization->p();
+        level.b = &level.discretization->rhs();
+        level.bGhost = 0;
+        level.bSign = 1.0;
+        level.parityOffset = (offset[0] + offset[1] + offset[2]) & 0b1;
+    }
+
+    Level &coarsest = levels_.back();
+    if(levels_.size() > 1 && coarsest.pi->totalNoOfCellsGlobal() <= agglomerationCells)
+    {
+        coarseSolver_ = std::make_shared<AgglomeratedPoisson>(*coarsest.pi, coarsest.discretization->dx2(),
+                                                              coarsest.discretization->dy2(), coarsest.discretization->dz2());
+    }
+
+    if(rank_ == 0)
+    {
+        const std::array<int, 3> nCoarsest = coarsest.partition->pi_.nCellsGlobal();
+        std::cout << "Multigrid uses " << levels_.size() << " levels, coarsest grid: "
+                  << nCoarsest[0] << 'x' << nCoarsest[1] << 'x' << nCoarsest[2]
+                  << (coarseSolver_ ? ", solved directly on rank 0" : "") << std::endl;
+    }
+}
+
+void Multigrid::step()
+{
+    // the boundary of the finest level was set in solve, the coarse levels set their own
+    Level &finest = levels_.front();
+    finest.x = &discretization_->p();
+    finest.b = &discretization_->rhs();
+    finest.bGhost = 0;
+    finest.bSign = 1.0;
+    vCycle(0);
+}
+
+void Multigrid::precondition(FieldVariable &residuum, FieldVariable &correction)
+{
+    // -Δ correction = residuum is Δ correction = -residuum, the zero start has a valid boundary
+    Level &finest = levels_.front();
+    finest.x = &correction;
+    finest.b = &residuum;
+    finest.bGhost = 1;
+    finest.bSign = -1.0;
+    correction.setToZero();
+    vCycle(0);
+}
+
+void Multigrid::vCycle(int l)
+{
+    Level &level = levels_[l];
+    if(l == (int)levels_.size() - 1)
+    {
+        if(coarseSolver_)
+        {
+            coarseSolver_->solve(*level.b, *level.x);
+            level.partition->setBoundaryCellField(*level.x);
+            return;
+        }
+        // the colours alternate symmetrically, starting and ending with red
+        relaxColour(level, 0);
+        for(int s = 0; s < coarseIterations_; s++)
+        {
+            relaxColour(level, 1);
+            relaxColour(level, 0);
+        }
+        return;
+    }
+
+    Level &coarse = levels_[l+1];
+    for(int s = 0; s < smoothingSteps_; s++)
+    {
+        relaxColour(level, 0);
+        relaxColour(level, 1);
+    }
+    restrictResiduum(level, coarse);
+    vCycle(l+1);
+    prolongateCorrection(coarse, level);
+    level.partition->setBoundaryCellField(*level.x);
+    // the reversed order of the colours makes the V-cycle symmetric
+    for(int s = 0; s < smoothingSteps_; s++)
+    {
+        relaxColour(level, 1);
+        relaxColour(level, 0);
+    }
+}
+
+void Multigrid::relaxColour(Level &level, int colour)
+{
+    const Discretization &d = *level.discretization;
+    const double invDx2 = 1. / d.dx2();
+    const double invDy2 = 1. / d.dy2();
+    const double invDz2 = 1. / d.dz2();
+    const double factor = 1. / (2. * (invDx2 + invDy2 + invDz2));
+    const double bScale = level.bSign * factor;
+
+    FieldVariable &x = *level.x;
+    const Array3DView xView = x.view(1, 1, 1);
+    const Array3DView b = level.b->view(level.bGhost, level.bGhost, level.bGhost);
+    const std::ptrdiff_t sy = xView.strideY();
+    const std::ptrdiff_t sz = xView.strideZ();
+    const int iN = d.piN();
+
+    // the ghost layers are valid on entry, so they are only set after each colour,
+    // which leaves them valid for the next colour, the residuum or the prolongation
+    for(int k = 0; k < d.pkN(); k++)
+    {
+        for(int j = 0; j < d.pjN(); j++)
+        {
+            double *row = xView.row(0, j, k);
+            const double *bRow = b.row(0, j, k);
+            for(int i = (j + k + level.parityOffset + colour) & 0b1; i < iN; i += 2)
+            {
+                row[i] = factor * ((row[i-1] + row[i+1]) * invDx2 + (row[i-sy] + row[i+sy]) * invDy2
+                                 + (row[i-sz] + row[i+sz]) * invDz2) - bScale * bRow[i];
+            }
+        }
+    }
+    level.partition->setBoundaryCellField(x);
+}
+
+void Multigrid::restrictResiduum(Level &fine, Level &coarse)
+{
+    const Discretization &f = *fine.discretization;
+    const double invDx2 = 1. / f.dx2();
+    const double invDy2 = 1. / f.dy2();
+    const double invDz2 = 1. / f.dz2();
+    const double diagonal = 2. * (invDx2 + invDy2 + invDz2);
+
+    FieldVariable &coarseB = *coarse.b;
+    const Array3DView x = fine.x->view(1, 1, 1);
+    const Array3DView b = fine.b->view(fine.bGhost, fine.bGhost, fine.bGhost);
+    const Array3DView coarseBView = coarseB.view();
+    const std::ptrdiff_t sy = x.strideY();
+    const std::ptrdiff_t sz = x.strideZ();
+    const std::array<int, 3> n{f.piN(), f.pjN(), f.pkN()};
+
+    // cell-centred full weighting is the mean of the 8 fine cells within each coarse cell, the last coarse cell
+    // of an odd partition covers fewer fine cells, but is still divided by 8: the coarse operator assumes the full
+    // coarse mesh width, so its equation is the flux balance of the full cell volume, which also keeps its
+    // correction from overshooting
+    coarseB.setToZero();
+    for(int k = 0; k < n[2]; k++)
+    {
+        for(int j = 0; j < n[1]; j++)
+        {
+            const double *row = x.row(0, j, k);
+            const double *bRow = b.row(0, j, k);
+            double *coarseRow = coarseBView.row(0, j/2, k/2);
+            for(int i = 0; i < n[0]; i++)
+            {
+                const double laplacian = (row[i-1] + row[i+1]) * invDx2 + (row[i-sy] + row[i+sy]) * invDy2
+                                       + (row[i-sz] + row[i+sz]) * invDz2 - diagonal * row[i];
+                coarseRow[i/2] += 0.125 * (fine.bSign * bRow[i] - laplacian);
+            }
+        }
+    }
+
+    // the coarse grid solves for the error, which is started from 0 (including the ghost layers)
+    coarse.x->setToZero();
+}
+
+void Multigrid::prolongateCorrection(Level &coarse, Level &fine)
+{
+    const Discretization &f = *fine.discretization;
+    const Array3DView x = fine.x->view(1, 1, 1);
+    const Array3DView e = coarse.x->view(1, 1, 1);
+    const std::ptrdiff_t sy = e.strideY();
+    const std::ptrdiff_t sz = e.strideZ();
+    const std::array<int, 3> n{f.piN(), f.pjN(), f.pkN()};
+
+    // each fine cell lies at a quarter of the coarse cell, so the weights are (3/4, 1/4) in each direction,
+    // a coarse cell of a single fine cell has the same centre, so it is not interpolated in that direction
+    auto neighbourWeight = [](int t, int nFine) { return (2*(t/2) + 1 < nFine) ? 0.25 : 0.0; };
+    for(int k = 0; k < n[2]; k++)
+    {
+        const double wk = neighbourWeight(k, n[2]);
+        const std::ptrdiff_t dk = (k & 0b1) ? sz : -sz;
+        for(int j = 0; j < n[1]; j++)
+        {
+            const double wj = neighbourWeight(j, n[1]);
+            const std::ptrdiff_t dj = (j & 0b1) ? sy : -sy;
+            double *row = x.row(0, j, k);
+            const double *coarseRow = e.row(0, j/2, k/2);
+            for(int i = 0; i < n[0]; i++)
+            {
+                const double wi = neighbourWeight(i, n[0]);
+                const std::ptrdiff_t di = (i & 0b1) ? 1 : -1;
+                const double *c = coarseRow + i/2;
+                const double lowerK = (1.-wj) * ((1.-wi) * c[0]     + wi * c[di])
+                                    +     wj  * ((1.-wi) * c[dj]    + wi * c[dj+di]);
+                const double upperK = (1.-wj) * ((1.-wi) * c[dk]    + wi * c[dk+di])
+                                    +     wj  * ((1.-wi) * c[dk+dj] + wi * c[dk+dj+di]);
+                row[i] += (1.-wk) * lowerK + wk * upperK;
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <memory>
+#include <cmath>
+#include <vector>
+#include <exception>
+#include <sstream>
+#include <mpi.h>
+#include "settings.h"
+#include "pressure_solver/pressure_solver.h"
+#include "pressure_solver/agglomerated_poisson.h"
+#include "discretization/discretization.h"
+#include "discretization/central_differences.h"
+#include "discretization/partition_shell.h"
+#include "discretization/partition_information.h"
+#include "discretization/async_partition.h"
+#include "storage/field_variable.h"
+
+//! Geometric multigrid solver, each step is one V-cycle over a hierarchy of coarsened grids.
+//! Each partition is coarsened locally by a factor of 2 in each direction, so every rank keeps the same
+//! neighbours on every level and exchanges its halos with the level's own AsyncPartition. An odd local cell count
+//! leaves a last coarse cell, which only covers one fine cell, so any partition size can be coarsened.
+//! Once the grid is small, the coarsest level is agglomerated onto rank 0 and solved directly.
+//! The smoothing is symmetric (red-black before, black-red after the coarse correction), so the V-cycle
+//! is also used as the preconditioner of MGCG.
+class Multigrid : public PressureSolver
+{
+public:
+    //! Builds the grid hierarchy, the number of levels is limited by the settings and by the
+    //! smallest partition, which needs at least 2 cells in each direction to be coarsened
+    Multigrid(std::shared_ptr<PartitionShell> partition, const Settings &settings);
+
+    //! one V-cycle on the finest grid
+    void step() override;
+
+    //! one V-cycle started from 0 for -Δ correction = residuum on the finest grid, both fields are indexed
+    //! including their ghost layer, the ghost layers of correction are overwritten
+    void precondition(FieldVariable &residuum, FieldVariable &correction);
+
+    //! returns the number of grid levels actually used
+    inline int nLevels() const { return levels_.size(); }
+
+    //! the coarsest level is solved directly on rank 0, if it has at most this many cells
+    static const int agglomerationCells = 4096;
+
+protected:
+    //! everything needed on one grid level, the finest level uses the solvers' partition
+    struct Level
+    {
+        //! only set on the coarse levels, the partition keeps a reference to it
+        std::shared_ptr<PartitionInformation> pi;
+        std::shared_ptr<Discretization> discretization;
+        std::shared_ptr<PartitionShell> partition;
+        //! the level solves Δx = bSign*b, x is indexed with its ghost layer, b with bGhost layers,
+        //! only the finest level switches between p, rhs and the fields of the preconditioner
+        FieldVariable *x;
+        FieldVariable *b;
+        int bGhost;
+        double bSign;
+        //! parity of the global index of the first cell of the partition
+        int parityOffset;
+    };
+
+    //! recursive V-cycle starting at level l
+    void vCycle(int l);
+
+    //! Gauss-Seidel relaxation of the cells of one colour, sets the boundary of x afterwards
+    void relaxColour(Level &level, int colour);
+
+    //! calculates the residuum on the fine level and averages it into the rhs of the coarse level
+    void restrictResiduum(Level &fine, Level &coarse);
+
+    //! interpolates the coarse correction trilinearly and adds it onto the fine level
+    void prolongateCorrection(Level &coarse, Level &fine);
+
+    std::vector<Level> levels_;
+
+    //! pre- and post-smoothing sweeps per level
+    const int smoothingSteps_;
+    //! sweeps used to solve the coarsest level, if it is not solved directly
+    const int coarseIterations_;
+    //! direct solver of the coarsest level, if it is small enough
+    std::shared_ptr<AgglomeratedPoisson> coarseSolver_;
+};
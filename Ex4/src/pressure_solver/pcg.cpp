@@ -0,0 +1,307 @@
+#include "pressure_solver/pcg.h"
+
+Preconditioner parsePreconditioner(const std::string &name)
+{
+    if(name == "None")
+        return Preconditioner::None;
+    else if(name == "Jacobi")
+        return Preconditioner::Jacobi;
+    else if(name == "SymmetricGaussSeidel")
+        return Preconditioner::SymmetricGaussSeidel;
+    else if(name == "SSOR")
+        return Preconditioner::SSOR;
+    else if(name == "Subdomain")
+        return Preconditioner::Subdomain;
+    else if(name == "Multigrid")
+        return Preconditioner::Multigrid;
+    else
+        throw std::invalid_argument("Invalid or non-implemented preconditioner: " + name + ", stop simulation\n.");
+}
+
+PCG::PCG(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations,
+         Preconditioner preconditioner, double omega, std::shared_ptr<Multigrid> multigrid) :
+         PressureSolver(partition, epsilon, maximumNumberOfIterations),
+         preconditioner_(preconditioner),
+         // symmetric Gauss-Seidel is SSOR without relaxation
+         omega_(preconditioner == Preconditioner::SymmetricGaussSeidel ? 1.0 : omega),
+         diagonal_(2./discretization_->dx2() + 2./discretization_->dy2() + 2./discretization_->dz2()),
+         multigrid_(multigrid), flexible_(preconditioner == Preconditioner::Multigrid)
+{
+    if(preconditioner_ == Preconditioner::SSOR && (omega <= 0.0 || omega >= 2.0))
+    {
+        std::stringstream str;
+        str << "Omega may only be 0.0 < "  << omega << " < 2.0!\n";
+        throw std::out_of_range(str.str());
+    }
+    if(preconditioner_ == Preconditioner::Multigrid && !multigrid_)
+        throw std::invalid_argument("The Multigrid preconditioner requires the multigrid hierarchy, it is only available for PCG\n");
+    if(preconditioner_ == Preconditioner::Subdomain)
+        subdomainSolver_ = std::make_shared<SubdomainPoisson>(partition_->pi_, discretization_->dx2(), 
+                                                              discretization_->dy2(), discretization_->dz2());
+    discretization_->makeCGFields();
+    cachesResiduum_ = true;
+}
+
+void PCG::init()
+{
+    const double dx2 = discretization_->dx2();
+    const double dy2 = discretization_->dy2();
+    const double dz2 = discretization_->dz2();
+    // Wiki notation: Ax = b, our notation -D2pDx2 - D2pDy2 - D2pDz2 = -RHS
+    // which makes r = -RHS + D2pDx2 + D2pDy2 + D2pDz2, the ghost layers of p were set in solve
+    const Array3DView p = discretization_->pView(), b = discretization_->rhsView();
+    const Array3DView r = discretization_->cellView(discretization_->r());
+    const Array3DView z = discretization_->cellView(discretization_->z());
+    const Array3DView a = discretization_->cellView(discretization_->a());
+    for(int k = 0; k < discretization_->pkN(); k++)
+    {
+        for(int j = 0; j < discretization_->pjN(); j++)
+        {
+            for(int i = 0; i < discretization_->piN(); i++)
+            {
+                const double D2pDx2 = (p(i+1,j,k) - 2.*p(i,j,k) + p(i-1,j,k)) / dx2;
+                const double D2pDy2 = (p(i,j+1,k) - 2.*p(i,j,k) + p(i,j-1,k)) / dy2;
+                const double D2pDz2 = (p(i,j,k+1) - 2.*p(i,j,k) + p(i,j,k-1)) / dz2;
+                r(i,j,k) = D2pDx2 + D2pDy2 + D2pDz2 - b(i,j,k);
+            }
+        }
+    }
+
+    applyPreconditioner(discretization_->r(), discretization_->z());
+
+    double local[2] = {0.0, 0.0};
+    for(int k = 0; k < discretization_->pkN(); k++)
+    {
+        for(int j = 0; j < discretization_->pjN(); j++)
+        {
+            for(int i = 0; i < discretization_->piN(); i++)
+            {
+                const double rValue = r(i,j,k);
+                const double zValue = z(i,j,k);
+                a(i,j,k) = zValue;
+                local[0] += rValue*zValue;
+                local[1] += rValue*rValue;
+            }
+        }
+    }
+    // both dot products are reduced at once
+    double global[2];
+    MPI_Allreduce(local, global, 2, MPI_DOUBLE, MPI_SUM, partition_->pi_.comm());
+    rz_ = global[0];
+    residuum2_ = global[1] / partition_->pi_.totalNoOfCellsGlobal();
+}
+
+void PCG::step()
+{
+    if(iteration_ == 0)
+        init();
+
+    // the initial guess is already the solution (e.g. for a resting fluid), alpha would be 0/0
+    if(rz_ == 0.0)
+        return;
+
+    // the stencil requires the neighbour values and the Neumann condition of the search direction
+    double aq_local = applyStencilWithHalo(discretization_->a(), discretization_->q());
+
+    // calculate alpha
+    double aq;
+    MPI_Allreduce(&aq_local, &aq, 1, MPI_DOUBLE, MPI_SUM, partition_->pi_.comm());
+    const double alpha = rz_ / aq;
+
+    const Array3DView p = discretization_->pView();
+    const Array3DView r = discretization_->cellView(discretization_->r());
+    const Array3DView z = discretization_->cellView(discretization_->z());
+    const Array3DView a = discretization_->cellView(discretization_->a());
+    const Array3DView q = discretization_->cellView(discretization_->q());
+
+    // iterate x (p in our case) and r
+    for(int k = 0; k < discretization_->pkN(); k++)
+    {
+        for(int j = 0; j < discretization_->pjN(); j++)
+        {
+            for(int i = 0; i < discretization_->piN(); i++)
+            {
+                p(i,j,k) += alpha * a(i,j,k);
+                r(i,j,k) -= alpha * q(i,j,k);
+            }
+        }
+    }
+
+    applyPreconditioner(discretization_->r(), discretization_->z());
+
+    // the flexible beta needs z^T*(r_new - r_old) = -alpha z^T*q, q is still the one of this iteration
+    double local[3] = {0.0, 0.0, 0.0};
+    for(int k = 0; k < discretization_->pkN(); k++)
+    {
+        for(int j = 0; j < discretization_->pjN(); j++)
+        {
+            for(int i = 0; i < discretization_->piN(); i++)
+            {
+                const double rValue = r(i,j,k);
+                const double zValue = z(i,j,k);
+                local[0] += rValue * zValue;
+                local[1] += rValue * rValue;
+                if(flexible_)
+                    local[2] += zValue * q(i,j,k);
+            }
+        }
+    }
+    double global[3];
+    MPI_Allreduce(local, global, flexible_ ? 3 : 2, MPI_DOUBLE, MPI_SUM, partition_->pi_.comm());
+    const double beta = flexible_ ? -alpha * global[2] / rz_ : global[0] / rz_;
+    rz_ = global[0];
+    residuum2_ = global[1] / partition_->pi_.totalNoOfCellsGlobal();
+
+    // update a (p in Wiki)
+    for(int k = 0; k < discretization_->pkN(); k++)
+    {
+        for(int j = 0; j < discretization_->pjN(); j++)
+        {
+            for(int i = 0; i < discretization_->piN(); i++)
+            {
+                a(i,j,k) = z(i,j,k) + beta * a(i,j,k);
+            }
+        }
+    }
+}
+
+void PCG::applyPreconditioner(FieldVariable &sourceField, FieldVariable &targetField)
+{
+    const double dx2 = discretization_->dx2();
+    const double dy2 = discretization_->dy2();
+    const double dz2 = discretization_->dz2();
+    const int iN = discretization_->piN();
+    const int jN = discretization_->pjN();
+    const int kN = discretization_->pkN();
+    const Array3DView source = sourceField.view(), target = targetField.view();
+
+    // the fields are indexed including their ghost layer, so the partition starts at 1
+    if(preconditioner_ == Preconditioner::None)
+    {
+        for(int k = 1; k <= kN; k++)
+            for(int j = 1; j <= jN; j++)
+                for(int i = 1; i <= iN; i++)
+                    target(i,j,k) = source(i,j,k);
+    }
+    else if(preconditioner_ == Preconditioner::Jacobi)
+    {
+        for(int k = 1; k <= kN; k++)
+            for(int j = 1; j <= jN; j++)
+                for(int i = 1; i <= iN; i++)
+                    target(i,j,k) = source(i,j,k) / diagonal_;
+    }
+    else if(preconditioner_ == Preconditioner::Subdomain)
+    {
+        subdomainSolver_->solve(sourceField, targetField);
+    }
+    else if(preconditioner_ == Preconditioner::Multigrid)
+    {
+        multigrid_->precondition(sourceField, targetField);
+    }
+    else
+    {
+        // One symmetric SOR sweep started from 0 applies the SSOR preconditioner.
+        // The ghost layers of the target have to be 0, which keeps the preconditioner local and symmetric,
+        // they may still hold the halo of an earlier use of the field. The forward sweep ignores the upper neighbours,
+        // as they are still 0.
+        for(int k = 0; k <= kN+1; k++)
+        {
+            for(int j = 0; j <= jN+1; j++)
+            {
+                target(0,j,k) = 0.0;
+                target(iN+1,j,k) = 0.0;
+            }
+            for(int i = 0; i <= iN+1; i++)
+            {
+                target(i,0,k) = 0.0;
+                target(i,jN+1,k) = 0.0;
+            }
+        }
+        for(int j = 0; j <= jN+1; j++)
+        {
+            for(int i = 0; i <= iN+1; i++)
+            {
+                target(i,j,0) = 0.0;
+                target(i,j,kN+1) = 0.0;
+            }
+        }
+        for(int k = 1; k <= kN; k++)
+        {
+            for(int j = 1; j <= jN; j++)
+            {
+                for(int i = 1; i <= iN; i++)
+                {
+                    const double lower = target(i-1,j,k) / dx2 + target(i,j-1,k) / dy2 + target(i,j,k-1) / dz2;
+                    target(i,j,k) = omega_ * (source(i,j,k) + lower) / diagonal_;
+                }
+            }
+        }
+        for(int k = kN; k >= 1; k--)
+        {
+            for(int j = jN; j >= 1; j--)
+            {
+                for(int i = iN; i >= 1; i--)
+                {
+                    const double t_last = target(i,j,k);
+                    const double neighbours = (target(i-1,j,k) + target(i+1,j,k)) / dx2
+                                            + (target(i,j-1,k) + target(i,j+1,k)) / dy2
+                                            + (target(i,j,k-1) + target(i,j,k+1)) / dz2;
+                    const double t_gs = (source(i,j,k) + neighbours) / diagonal_;
+                    target(i,j,k) = t_last + omega_ * (t_gs - t_last);
+                }
+            }
+        }
+    }
+}
+
+double PCG::applyStencil(FieldVariable &sourceField, FieldVariable &targetField, GridRegion region)
+{
+    const double dx2 = discretization_->dx2();
+    const double dy2 = discretization_->dy2();
+    const double dz2 = discretization_->dz2();
+    const Array3DView source = sourceField.view(), target = targetField.view();
+    const int iN = discretization_->piN(), jN = discretization_->pjN(), kN = discretization_->pkN();
+
+    double dot = 0.0;
+    for(int k = 1; k <= kN; k++)
+    {
+        for(int j = 1; j <= jN; j++)
+        {
+            // the region counts the cells of the partition from 0, the fields from their ghost layer
+            forRowSegments(region, discretization_->shellWidth(), j-1, k-1, iN, jN, kN, [&](int iBegin, int iEnd)
+            {
+                for(int i = iBegin+1; i <= iEnd; i++)
+                {
+                    const double s = source(i,j,k);
+                    const double t = diagonal_ * s
+                        - (source(i-1,j,k) + source(i+1,j,k)) / dx2
+                        - (source(i,j-1,k) + source(i,j+1,k)) / dy2
+                        - (source(i,j,k-1) + source(i,j,k+1)) / dz2;
+                    target(i,j,k) = t;
+                    dot += s*t;
+                }
+            });
+        }
+    }
+    return dot;
+}
+
+double PCG::applyStencilWithHalo(FieldVariable &source, FieldVariable &target)
+{
+    // only the shell reads the ghost layers of the neighbours, so the interior is calculated during the exchange
+    if(!useOverlappedComm_)
+    {
+        partition_->setBoundaryCellField(source);
+        return applyStencil(source, target);
+    }
+    partition_->startBoundaryCellField(source);
+    double dot = applyStencil(source, target, GridRegion::Interior);
+    partition_->finishBoundaryCellField(source);
+    dot += applyStencil(source, target, GridRegion::Shell);
+    return dot;
+}
+
+double PCG::calculateResiduum2()
+{
+    return residuum2_;
+}
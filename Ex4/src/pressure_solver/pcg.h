@@ -0,0 +1,83 @@
+#pragma once
+
+#include <memory>
+#include <cmath>
+#include <string>
+#include <exception>
+#include <sstream>
+#include <mpi.h>
+#include "pressure_solver/pressure_solver.h"
+#include "pressure_solver/subdomain_poisson.h"
+#include "pressure_solver/multigrid.h"
+#include "discretization/discretization.h"
+#include "discretization/partition_shell.h"
+#include "storage/field_variable.h"
+
+//! Preconditioners of the PCG solver, all of them except Multigrid are applied locally on each partition
+//! (block-Jacobi over the ranks), so they do not require any communication
+enum class Preconditioner : char
+{
+    None                 = 'N',
+    Jacobi               = 'J',
+    SymmetricGaussSeidel = 'G',
+    SSOR                 = 'S',
+    //! exact solve of the partition with Dirichlet faces towards the neighbours
+    Subdomain            = 'D',
+    //! one V-cycle of the multigrid solver over all ranks (MGCG)
+    Multigrid            = 'M'
+};
+
+//! converts the name used in the settings file into the preconditioner
+Preconditioner parsePreconditioner(const std::string &name);
+
+// Implemented using https://en.wikipedia.org/wiki/Conjugate_gradient_method
+//! Preconditioned conjugate gradient solver, each step is one CG iteration.
+//! It solves -Δp = -rhs, as the negative laplacian is positive (semi-)definite.
+class PCG : public PressureSolver
+{
+public:
+    //! Same as pressure-solver constructor with additional instantiation of the CG fields,
+    //! omega is only used by the SSOR preconditioner, multigrid only by the Multigrid preconditioner,
+    //! which has to be built on the same partition
+    PCG(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations,
+        Preconditioner preconditioner, double omega, std::shared_ptr<Multigrid> multigrid = nullptr);
+
+    void step() override;
+
+protected:
+    //! initialize step is called before the first iteration to set r, z and a
+    void init();
+
+    //! solves M*target = source with the chosen preconditioner, the ghost layers of target are overwritten
+    void applyPreconditioner(FieldVariable &source, FieldVariable &target);
+
+    //! target = -Δ source on the region of the partition, the ghost layers of source towards the neighbours are only read by the shell,
+    //! returns the local part of the dot product source^T*target
+    double applyStencil(FieldVariable &source, FieldVariable &target, GridRegion region = GridRegion::All);
+
+    //! sets the ghost layers of source and applies the stencil, with useOverlappedComm_ the interior is calculated
+    //! during the exchange, returns the local part of source^T*target
+    double applyStencilWithHalo(FieldVariable &source, FieldVariable &target);
+
+    //! r is updated in each step, so its norm is already known without another pass over the grid
+    double calculateResiduum2() override;
+
+    const Preconditioner preconditioner_;
+    const double omega_;
+
+    //! diagonal of the negative laplacian stencil
+    const double diagonal_;
+
+    //! direct solver of the partition, only used by the Subdomain preconditioner
+    std::shared_ptr<SubdomainPoisson> subdomainSolver_;
+    //! V-cycle of the Multigrid preconditioner
+    std::shared_ptr<Multigrid> multigrid_;
+    //! The V-cycle is not exactly symmetric, as the restriction is not the transpose of the trilinear prolongation.
+    //! The flexible (Polak-Ribiere) beta keeps the search directions conjugate enough for such a preconditioner.
+    const bool flexible_;
+
+    //! global r^T*z of the current iteration
+    double rz_ = 0.0;
+    //! global r^T*r of the current iteration, normalized like calculateResiduum2
+    double residuum2_ = 0.0;
+};
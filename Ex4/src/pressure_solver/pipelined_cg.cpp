@@ -0,0 +1,141 @@
+#include "pressure_solver/pipelined_cg.h"
+
+PipelinedCG::PipelinedCG(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations,
+                         Preconditioner preconditioner, double omega) :
+                         PCG(partition, epsilon, maximumNumberOfIterations, preconditioner, omega)
+{
+    discretization_->makePipelinedCGFields();
+}
+
+void PipelinedCG::init()
+{
+    // same residuum as in PCG, the ghost layers of p were set in solve
+    const double dx2 = discretization_->dx2();
+    const double dy2 = discretization_->dy2();
+    const double dz2 = discretization_->dz2();
+    const Array3DView p = discretization_->pView(), b = discretization_->rhsView();
+    const Array3DView r = discretization_->cellView(discretization_->r());
+    const Array3DView z = discretization_->cellView(discretization_->z());
+    for(int k = 0; k < discretization_->pkN(); k++)
+    {
+        for(int j = 0; j < discretization_->pjN(); j++)
+        {
+            for(int i = 0; i < discretization_->piN(); i++)
+            {
+                const double D2pDx2 = (p(i+1,j,k) - 2.*p(i,j,k) + p(i-1,j,k)) / dx2;
+                const double D2pDy2 = (p(i,j+1,k) - 2.*p(i,j,k) + p(i,j-1,k)) / dy2;
+                const double D2pDz2 = (p(i,j,k+1) - 2.*p(i,j,k) + p(i,j,k-1)) / dz2;
+                r(i,j,k) = D2pDx2 + D2pDy2 + D2pDz2 - b(i,j,k);
+            }
+        }
+    }
+
+    applyPreconditioner(discretization_->r(), discretization_->z());
+    localDots_[1] = applyStencilWithHalo(discretization_->z(), discretization_->az());
+
+    localDots_[0] = 0.0;
+    localDots_[2] = 0.0;
+    for(int k = 0; k < discretization_->pkN(); k++)
+    {
+        for(int j = 0; j < discretization_->pjN(); j++)
+        {
+            for(int i = 0; i < discretization_->piN(); i++)
+            {
+                localDots_[0] += r(i,j,k) * z(i,j,k);
+                localDots_[2] += r(i,j,k) * r(i,j,k);
+            }
+        }
+    }
+}
+
+void PipelinedCG::step()
+{
+    if(iteration_ == 0)
+        init();
+
+    // all dot products of this iteration are reduced at once in the background
+    double global[3];
+    MPI_Request reduction;
+    MPI_Iallreduce(localDots_, global, 3, MPI_DOUBLE, MPI_SUM, partition_->pi_.comm(), &reduction);
+
+    // maz = M^-1*az and amaz = A*maz do not depend on the dot products, they hide the reduction
+    applyPreconditioner(discretization_->az(), discretization_->maz());
+    // some MPI implementations only progress the reduction within MPI calls
+    int reductionDone;
+    MPI_Test(&reduction, &reductionDone, MPI_STATUS_IGNORE);
+    applyStencilWithHalo(discretization_->maz(), discretization_->amaz());
+
+    #ifdef TIMER
+    // only the part of the reduction, which could not be hidden, is tracked
+    timer_.setT0();
+    #endif
+    MPI_Wait(&reduction, MPI_STATUS_IGNORE);
+    #ifdef TIMER
+    timer_.addTimeSinceT0();
+    #endif
+
+    // the norm belongs to the residuum before this iteration's update, so the convergence
+    // check lags behind one iteration, which is the price for the single reduction
+    const double rz = global[0];
+    const double azz = global[1];
+    residuum2_ = global[2] / partition_->pi_.totalNoOfCellsGlobal();
+
+    // the initial guess is already the solution (e.g. for a resting fluid), alpha would be 0/0
+    if(rz == 0.0)
+        return;
+
+    double alpha, beta;
+    if(iteration_ == 0)
+    {
+        beta = 0.0;
+        alpha = rz / azz;
+    }
+    else
+    {
+        beta = rz / rzLast_;
+        alpha = rz / (azz - beta * rz / alphaLast_);
+    }
+    rzLast_ = rz;
+    alphaLast_ = alpha;
+
+    // the recurrences replace the stencil of the search direction and the preconditioner of the residuum,
+    // the dot products of the next iteration are summed up in the same pass
+    const Array3DView p = discretization_->pView();
+    const Array3DView r = discretization_->cellView(discretization_->r());
+    const Array3DView z = discretization_->cellView(discretization_->z());
+    const Array3DView a = discretization_->cellView(discretization_->a());
+    const Array3DView q = discretization_->cellView(discretization_->q());
+    const Array3DView az = discretization_->cellView(discretization_->az());
+    const Array3DView mq = discretization_->cellView(discretization_->mq());
+    const Array3DView amq = discretization_->cellView(discretization_->amq());
+    const Array3DView maz = discretization_->cellView(discretization_->maz());
+    const Array3DView amaz = discretization_->cellView(discretization_->amaz());
+    double localDots[3] = {0.0, 0.0, 0.0};
+    for(int k = 0; k < discretization_->pkN(); k++)
+    {
+        for(int j = 0; j < discretization_->pjN(); j++)
+        {
+            for(int i = 0; i < discretization_->piN(); i++)
+            {
+                amq(i,j,k) = amaz(i,j,k) + beta * amq(i,j,k);
+                mq(i,j,k) = maz(i,j,k) + beta * mq(i,j,k);
+                q(i,j,k) = az(i,j,k) + beta * q(i,j,k);
+                a(i,j,k) = z(i,j,k) + beta * a(i,j,k);
+
+                p(i,j,k) += alpha * a(i,j,k);
+                const double r_new = r(i,j,k) - alpha * q(i,j,k);
+                const double z_new = z(i,j,k) - alpha * mq(i,j,k);
+                const double az_new = az(i,j,k) - alpha * amq(i,j,k);
+                r(i,j,k) = r_new;
+                z(i,j,k) = z_new;
+                az(i,j,k) = az_new;
+
+                localDots[0] += r_new * z_new;
+                localDots[1] += az_new * z_new;
+                localDots[2] += r_new * r_new;
+            }
+        }
+    }
+    for(int d = 0; d < 3; d++)
+        localDots_[d] = localDots[d];
+}
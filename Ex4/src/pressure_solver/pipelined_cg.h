@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <cmath>
+#include <mpi.h>
+#include "pressure_solver/pcg.h"
+#include "discretization/discretization.h"
+#include "discretization/partition_shell.h"
+#include "storage/field_variable.h"
+
+// Implemented using P. Ghysels, W. Vanroose: Hiding global synchronization latency
+// in the preconditioned Conjugate Gradient algorithm, Parallel Computing 40 (2014), Alg. 4
+//! Pipelined preconditioned CG, each step is one CG iteration with a single global reduction.
+//! The three dot products are reduced with one MPI_Iallreduce, which runs in the background
+//! while the preconditioner, the halo exchange and the stencil of the next search space vector are computed.
+//! It trades these latencies for 5 additional fields and 4 additional vector updates per iteration,
+//! so it only pays off, if the reduction dominates, e.g. for strong scaling on many ranks.
+class PipelinedCG : public PCG
+{
+public:
+    //! Same as the PCG constructor with additional instantiation of the pipelined CG fields
+    PipelinedCG(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations,
+                Preconditioner preconditioner, double omega);
+
+    void step() override;
+
+protected:
+    //! initialize step is called before the first iteration to set r, z, az and the local dot products
+    void init();
+
+    //! local parts of r^T*z, az^T*z and r^T*r, they are calculated along the vector updates
+    //! of the previous iteration, so the reduction may be started right at the begin of the step
+    double localDots_[3] = {0.0, 0.0, 0.0};
+
+    //! alpha and r^T*z of the previous iteration, required by the recurrences
+    double alphaLast_ = 0.0;
+    double rzLast_ = 0.0;
+};
@@ -17,23 +17,102 @@ PressureSolver::PressureSolver(std::shared_ptr<PartitionShell> partition,
 
 bool PressureSolver::solve(double debugDt)
 {
-    // set the initial residuum to max, it is updated in each step
-    double residuum2;
+    // set the initial residuum to max, it is updated in each checked step
+    double residuum2 = std::numeric_limits<double>::max();
     iteration_ = 0;
+    const bool sweepResiduum = useSweepResiduum_ && providesSweepResiduum_;
+    // solvers, which already know their (reduced) residuum, do not benefit from the non-blocking reduction
+    const bool nonBlockingResiduum = useNonBlockingResiduum_ && !cachesResiduum_;
+    // the ghost layers are as up to date for the residuum as without the overlap, only the step sets them itself
+    const bool overlapsHaloOfP = useOverlappedComm_ && overlapsHaloOfP_;
+
+    // buffers of the non-blocking reduction, which is in flight during the next step
+    MPI_Request residuumRequest = MPI_REQUEST_NULL;
+    double partitionResiduum2, overallResiduum2;
 
     // runs, until either the residuum is small, or it hits the max no. of iterations
     do
     {
-        partition_->setBoundaryP();
-        // each step updates the pressure and returns the current residuum
+        if(!keepsOwnHalo_ && !overlapsHaloOfP)
+            partition_->setBoundaryP();
+        // each step updates the pressure
         step();
-        residuum2 = calculateResiduum2();
+
+        if(residuumRequest != MPI_REQUEST_NULL)
+        {
+            // the step above was speculative, it is simply accepted, as it only improves the solution
+            residuum2 = waitForResiduum2(residuumRequest, overallResiduum2);
+            if(residuum2 <= epsilon2_)
+                break;
+        }
+
+        const bool checkResiduum = (iteration_+1) % residuumCheckInterval_ == 0 
+                                || iteration_+1 == maximumNumberOfIterations_;
+        if(!checkResiduum)
+        {
+            #ifdef TIMER
+            nSkippedResiduumChecks_++;
+            #endif
+            continue;
+        }
+        if(nonBlockingResiduum)
+        {
+            #ifdef TIMER
+            timer_.setT0();
+            if(!sweepResiduum)
+                nFullResiduumChecks_++;
+            #endif
+            if(keepsOwnHalo_ && !sweepResiduum)
+                partition_->setBoundaryP();
+            // the sweep residuum is exact or close to it, the last step can not be confirmed without blocking anyway
+            partitionResiduum2 = sweepResiduum ? sweepResiduum2_ : calculatePartitionResiduum2();
+            MPI_Iallreduce(&partitionResiduum2, &overallResiduum2, 1, MPI_DOUBLE, MPI_SUM, partition_->pi_.comm(), &residuumRequest);
+            #ifdef TIMER
+            timer_.addTimeSinceT0();
+            #endif
+        }
+        else if(sweepResiduum)
+        {
+            residuum2 = reduceSweepResiduum2();
+            // the sweep residuum belongs to the previous iterate (or is only an estimate), so convergence is
+            // confirmed with the residuum of the current one, which is just one extra pass over the grid per solve
+            if(residuum2 <= epsilon2_)
+            {
+                partition_->setBoundaryP();
+                residuum2 = calculateResiduum2();
+            }
+        }
+        else
+        {
+            if(keepsOwnHalo_)
+                partition_->setBoundaryP();
+            residuum2 = calculateResiduum2();
+        }
         //std::cout << "Res2: " << residuum2 << std::endl;
     } while (residuum2 > epsilon2_ && ++iteration_ < maximumNumberOfIterations_);
+    // the maximum number of iterations was hit with a reduction in flight
+    if(residuumRequest != MPI_REQUEST_NULL)
+        residuum2 = waitForResiduum2(residuumRequest, overallResiduum2);
     #ifdef SOLVER_STATISTICS
     solverStepStatistics_.push_back(iteration_);
+    // the rate of this solve gives the iterations, the solver would have needed to reduce the
+    // residuum of the last solution to the one of its extrapolation
+    if(extrapolatedResiduum2_ > 0.0 && unextrapolatedResiduum2_ > 0.0)
+    {
+        logResiduumReduction_ += 0.5 * std::log(unextrapolatedResiduum2_ / extrapolatedResiduum2_);
+        nExtrapolations_++;
+    }
+    if(extrapolatedResiduum2_ > 0.0 && unextrapolatedResiduum2_ > 0.0 && iteration_ > 0 && residuum2 < extrapolatedResiduum2_)
+    {
+        savedIterationsEstimate_ += iteration_ * std::log(unextrapolatedResiduum2_ / extrapolatedResiduum2_)
+                                               / std::log(extrapolatedResiduum2_ / residuum2);
+    }
+    unextrapolatedResiduum2_ = 0.0;
+    extrapolatedResiduum2_ = 0.0;
     #endif
     partition_->setBoundaryP();
+    if(extrapolationOrder_ > 0)
+        storeSolution();
 
     const bool converged = residuum2 <= epsilon2_;
     #ifndef NDEBUG
@@ -55,44 +134,176 @@ bool PressureSolver::solve(double debugDt)
     return converged;
 }
 
+void PressureSolver::setResiduumCheckInterval(int interval)
+{
+    if(interval < 1)
+    {
+        std::stringstream str;
+        str << "The residuum check interval has to be at least 1, but is " << interval << "!\n";
+        throw std::out_of_range(str.str());
+    }
+    residuumCheckInterval_ = interval;
+}
+
+void PressureSolver::setExtrapolationOrder(int order)
+{
+    if(order < 0 || order > 2)
+    {
+        std::stringstream str;
+        str << "The pressure extrapolation order may only be 0, 1 or 2, but is " << order << "!\n";
+        throw std::out_of_range(str.str());
+    }
+    extrapolationOrder_ = order;
+}
+
+void PressureSolver::extrapolateInitialGuess(double deltaT)
+{
+    historyTime_ += deltaT;
+    // the last solution is already the initial guess
+    if(pHistory_.size() < 2)
+        return;
+
+    FieldVariable &p = discretization_->p();
+    #ifdef SOLVER_STATISTICS
+    // the ghost layers of p and of the extrapolation are set, as they are a combination of set fields
+    double partitionResiduum2 = calculatePartitionResiduum2();
+    MPI_Allreduce(&partitionResiduum2, &unextrapolatedResiduum2_, 1, MPI_DOUBLE, MPI_SUM, partition_->pi_.comm());
+    #endif
+
+    // lagrange polynomial through the stored solutions, evaluated at the time of this step,
+    // the adaptive time steps make the nodes non-equidistant
+    const std::size_t nStored = pHistory_.size();
+    std::vector<double> weights(nStored, 1.0);
+    for(std::size_t m = 0; m < nStored; m++)
+        for(std::size_t l = 0; l < nStored; l++)
+            if(l != m)
+                weights[m] *= (historyTime_ - pHistoryTimes_[l]) / (pHistoryTimes_[m] - pHistoryTimes_[l]);
+
+    double *pData = p.data();
+    for(std::size_t index = 0; index < p.length(); index++)
+    {
+        double guess = 0.0;
+        for(std::size_t m = 0; m < nStored; m++)
+            guess += weights[m] * pHistory_[m][index];
+        pData[index] = guess;
+    }
+
+    #ifdef SOLVER_STATISTICS
+    partitionResiduum2 = calculatePartitionResiduum2();
+    MPI_Allreduce(&partitionResiduum2, &extrapolatedResiduum2_, 1, MPI_DOUBLE, MPI_SUM, partition_->pi_.comm());
+    // normalized like calculateResiduum2, so it may be compared to the final residuum of solve
+    unextrapolatedResiduum2_ /= partition_->pi_.totalNoOfCellsGlobal();
+    extrapolatedResiduum2_ /= partition_->pi_.totalNoOfCellsGlobal();
+    #endif
+}
+
+void PressureSolver::storeSolution()
+{
+    // the oldest solution is reused as buffer of the newest one
+    if((int)pHistory_.size() > extrapolationOrder_)
+    {
+        pHistory_.push_front(std::move(pHistory_.back()));
+        pHistory_.pop_back();
+        pHistoryTimes_.pop_back();
+    }
+    else
+        pHistory_.emplace_front();
+    FieldVariable &p = discretization_->p();
+    pHistory_.front().assign(p.data(), p.data() + p.length());
+    pHistoryTimes_.push_front(historyTime_);
+}
+
+double PressureSolver::reduceSweepResiduum2()
+{
+    #ifdef TIMER
+    timer_.setT0();
+    #endif
+
+    double overallResiduum;
+    MPI_Allreduce(&sweepResiduum2_, &overallResiduum, 1, MPI_DOUBLE, MPI_SUM, partition_->pi_.comm());
+
+    #ifdef TIMER
+    const double duration = timer_.getDurationSinceT0s();
+    timer_.addTime(duration);
+    sweepResiduumTime_ += duration;
+    nSweepResiduumChecks_++;
+    #endif
+
+    return overallResiduum / partition_->pi_.totalNoOfCellsGlobal();
+}
+
 double PressureSolver::calculateResiduum2()
 {
     #ifdef TIMER
     timer_.setT0();
+    nFullResiduumChecks_++;
+    #endif
+
+    const double partitionResiduum = calculatePartitionResiduum2();
+    double overallResiduum;
+    MPI_Allreduce(&partitionResiduum, &overallResiduum, 1, MPI_DOUBLE, MPI_SUM, partition_->pi_.comm());
+    
+    #ifdef TIMER
+    timer_.addTimeSinceT0();
     #endif
 
+    return overallResiduum / partition_->pi_.totalNoOfCellsGlobal();
+}
+
+double PressureSolver::calculatePartitionResiduum2()
+{
     double partitionResiduum = 0;
-    const double dx2 = discretization_->dx2();
-    const double dy2 = discretization_->dy2();
-    const double dz2 = discretization_->dz2();
+    const double invDx2 = 1. / discretization_->dx2();
+    const double invDy2 = 1. / discretization_->dy2();
+    const double invDz2 = 1. / discretization_->dz2();
+    const Array3DView p = discretization_->pView(), b = discretization_->rhsView();
 
-    #pragma omp simd collapse(3) reduction(+:partitionResiduum)
+    #pragma omp parallel for collapse(2) reduction(+:partitionResiduum)
     for(int k = 0; k < discretization_->pkN(); k++)
     {
         for(int j = 0; j < discretization_->pjN(); j++)
         {
+            #pragma omp simd reduction(+:partitionResiduum)
             for(int i = 0; i < discretization_->piN(); i++)
             {
-                const double rhs   = discretization_->rhs(i,j,k);            
-                const double D2px2 = discretization_->computeD2pDx2(i,j,k);
-                const double D2py2 = discretization_->computeD2pDy2(i,j,k);
-                const double D2pz2 = discretization_->computeD2pDz2(i,j,k);
-                const double res_ij = rhs - D2px2 - D2py2 - D2pz2;
+                const double D2px2 = (p(i+1,j,k) - 2.*p(i,j,k) + p(i-1,j,k)) * invDx2;
+                const double D2py2 = (p(i,j+1,k) - 2.*p(i,j,k) + p(i,j-1,k)) * invDy2;
+                const double D2pz2 = (p(i,j,k+1) - 2.*p(i,j,k) + p(i,j,k-1)) * invDz2;
+                const double res_ij = b(i,j,k) - D2px2 - D2py2 - D2pz2;
 
                 partitionResiduum += res_ij*res_ij;
             }
         }
     }
+    return partitionResiduum;
+}
+
+double PressureSolver::waitForResiduum2(MPI_Request &request, const double &overallResiduum2)
+{
+    #ifdef TIMER
+    // only the part of the reduction, which was not hidden behind the step, is tracked
+    timer_.setT0();
+    #endif
+
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
 
-    double overallResiduum;
-    MPI_Allreduce(&partitionResiduum, &overallResiduum, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-    
     #ifdef TIMER
     timer_.addTimeSinceT0();
     #endif
 
-    return overallResiduum / partition_->pi_.totalNoOfCellsGlobal();
+    return overallResiduum2 / partition_->pi_.totalNoOfCellsGlobal();
+}
+
+#ifdef TIMER
+double PressureSolver::estimateSavedResiduumTime() const
+{
+    if(nFullResiduumChecks_ == 0)
+        return 0.0;
+    const double fullCheckTime = (timer_.getCummulatedTime() - sweepResiduumTime_) / nFullResiduumChecks_;
+    const double sweepCheckTime = nSweepResiduumChecks_ > 0 ? sweepResiduumTime_ / nSweepResiduumChecks_ : 0.0;
+    return nSkippedResiduumChecks_ * fullCheckTime + nSweepResiduumChecks_ * (fullCheckTime - sweepCheckTime);
 }
+#endif
 
 void PressureSolver::printIterationStats()
 {
@@ -105,6 +316,10 @@ void PressureSolver::printIterationStats()
     std_dev = std::sqrt(std_dev / solverStepStatistics_.size());
     std::cout << "Solver " << typeid(*this).name() << " stats: mean = " << mean 
               << ", std-dev = " << std_dev << ", overall steps = " << sum << std::endl;
+    if(nExtrapolations_ > 0)
+        std::cout << "The extrapolated initial guess reduced the initial residuum by a mean factor of " 
+                  << std::exp(logResiduumReduction_ / nExtrapolations_) << " and saved about " 
+                  << savedIterationsEstimate_ << " steps (estimate from the convergence rates)" << std::endl;
     #else
     std::cerr << "To print pressure solver statistics, set DSOLVER_STATISTICS=1\n";
     #endif
@@ -6,6 +6,8 @@
 #include <cmath>
 #include <exception>
 #include <vector>
+#include <deque>
+#include <sstream>
 #include <mpi.h>
 #include "timekeeper.h"
 #include "discretization/partition_shell.h"
@@ -27,9 +29,34 @@ public:
     //! returns the last number of iterations, the solver used
     inline int getLastIterations() const { return iteration_; }
 
+    //! the residuum is only checked after every interval-th step (and after the last allowed step)
+    void setResiduumCheckInterval(int interval);
+
+    //! solvers, which provide it, check the residuum accumulated within their sweep instead of an extra pass
+    //! over the grid, the convergence is still confirmed by calculateResiduum2
+    inline void setUseSweepResiduum(bool use) { useSweepResiduum_ = use; }
+
+    //! the residuum is reduced with MPI_Iallreduce, while the next step is already calculated,
+    //! so the convergence is decided one step late and the additional step is kept
+    inline void setUseNonBlockingResiduum(bool use) { useNonBlockingResiduum_ = use; }
+
+    //! solvers, which support it, exchange their halos while they relax the interior of the partition
+    inline void setUseOverlappedComm(bool use) { useOverlappedComm_ = use; }
+
+    //! the initial guess of each solve is extrapolated from the solutions of the last order+1 time steps,
+    //! 0 starts from the last solution, 1 and 2 extrapolate linearly and quadratically
+    void setExtrapolationOrder(int order);
+
+    //! replaces p by the extrapolation to the end of the time step of length deltaT, which is solved next
+    void extrapolateInitialGuess(double deltaT);
+
     #ifdef TIMER
     //! timer
     Timekeeper timer_;
+
+    //! estimates the time saved by skipped and fused residuum checks on this rank,
+    //! based on the mean time of the full residuum checks
+    double estimateSavedResiduumTime() const;
     #endif
 
 protected:
@@ -43,7 +70,17 @@ protected:
     //! Check the residuum in each computation step
     //! calculated using the difference to the solution with euclidian norm
     //! returns the squared result so it may be added over the whole domain and then sqrt
-    double calculateResiduum2();
+    //! solvers, which already know their residuum, may override it
+    virtual double calculateResiduum2();
+
+    //! the squared residuum of this partition without the reduction over all ranks
+    double calculatePartitionResiduum2();
+
+    //! reduces the residuum accumulated by the last sweep over all ranks, normalized like calculateResiduum2
+    double reduceSweepResiduum2();
+
+    //! completes the non-blocking reduction into overallResiduum2 and normalizes it like calculateResiduum2
+    double waitForResiduum2(MPI_Request &request, const double &overallResiduum2);
 
     std::shared_ptr<PartitionShell> partition_;
     const std::shared_ptr<Discretization> discretization_;
@@ -51,8 +88,51 @@ protected:
     const int maximumNumberOfIterations_;
     const int rank_;
 
+    int residuumCheckInterval_ = 1;
+    bool useSweepResiduum_ = false;
+    bool useNonBlockingResiduum_ = false;
+    //! set by solvers, which override calculateResiduum2 with a residuum, they already reduced within their step
+    bool cachesResiduum_ = false;
+    //! set by solvers, which exchange their own halo within step, so the ghost layers of p are only set for the residuum
+    bool keepsOwnHalo_ = false;
+    //! set by setUseOverlappedComm, the solvers choose the parts of their step, which overlap with an exchange
+    bool useOverlappedComm_ = false;
+    //! set by solvers, whose step starts with setBoundaryP itself with useOverlappedComm_, to overlap it with the interior
+    bool overlapsHaloOfP_ = false;
+    //! set by solvers, which sum up the squared residuum of the iterate the sweep started from in sweepResiduum2_,
+    //! for Checkerboard it is only an estimate, as the black cells already see the updated red cells
+    bool providesSweepResiduum_ = false;
+    //! residuum of the partition accumulated in the last step, only valid if providesSweepResiduum_
+    double sweepResiduum2_ = 0.0;
+
+    #ifdef TIMER
+    //! number of full, fused and skipped residuum checks, used to estimate the saved time
+    long nFullResiduumChecks_ = 0;
+    long nSweepResiduumChecks_ = 0;
+    long nSkippedResiduumChecks_ = 0;
+    //! part of timer_ spent on the sweep residuum reduction
+    double sweepResiduumTime_ = 0.0;
+    #endif
+
+    //! stores the solution at the end of solve in the history used by extrapolateInitialGuess
+    void storeSolution();
+
+    //! the previous solutions, the newest first, and the times they belong to
+    int extrapolationOrder_ = 0;
+    std::deque<std::vector<double>> pHistory_;
+    std::deque<double> pHistoryTimes_;
+    //! time of the step, which is solved next, only the differences matter
+    double historyTime_ = 0.0;
+
     #ifdef SOLVER_STATISTICS
     //! overall step of simulation
     std::vector<int> solverStepStatistics_;
+    //! residuum of the last solution and of its extrapolation, used to estimate the saved iterations
+    double unextrapolatedResiduum2_ = 0.0;
+    double extrapolatedResiduum2_ = 0.0;
+    double savedIterationsEstimate_ = 0.0;
+    //! sum of the logarithms of the residuum reductions by the extrapolations
+    double logResiduumReduction_ = 0.0;
+    int nExtrapolations_ = 0;
     #endif
 };
\ No newline at end of file
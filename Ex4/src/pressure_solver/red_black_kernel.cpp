@@ -0,0 +1,157 @@
+#include "pressure_solver/red_black_kernel.h"
+
+// the SIMD kernels are compiled with their own target attribute, so they are available without -march=native
+// and are only called, if the CPU supports them
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RED_BLACK_X86
+#include <immintrin.h>
+#endif
+
+namespace RedBlackKernel
+{
+
+double scalarRow(double *p, const double *rhs, std::ptrdiff_t sy, std::ptrdiff_t sz,
+                 int first, int n, const RedBlackCoefficients &c)
+{
+    double correction2 = 0.0;
+    for(int i = first; i < n; i += 2)
+        correction2 += cell(p + i, rhs + i, sy, sz, c);
+    return correction2;
+}
+
+#ifdef RED_BLACK_X86
+// The x neighbours are shifted out of the vectors of the row next to each other instead of loading them unaligned,
+// as a load of p+i-1 would overlap the store of the previous vector, which stalls the store forwarding.
+// The left neighbour of a cell of the colour is of the other colour, so the vector before the update is carried over,
+// which keeps the update of the previous vector out of the dependency chain.
+
+__attribute__((target("avx2,fma")))
+static double avx2Row(double *p, const double *rhs, std::ptrdiff_t sy, std::ptrdiff_t sz,
+                      int first, int n, const RedBlackCoefficients &c)
+{
+    const __m256d invDx2 = _mm256_set1_pd(c.invDx2);
+    const __m256d invDy2 = _mm256_set1_pd(c.invDy2);
+    const __m256d invDz2 = _mm256_set1_pd(c.invDz2);
+    const __m256d factor = _mm256_set1_pd(c.factor);
+    const __m256d omega = _mm256_set1_pd(c.omega);
+    // the vectors start at even cells, so the lanes of the colour are the same in each of them
+    const __m256d colour = first == 0 ? _mm256_castsi256_pd(_mm256_setr_epi64x(-1, 0, -1, 0))
+                                      : _mm256_castsi256_pd(_mm256_setr_epi64x(0, -1, 0, -1));
+    __m256d sum = _mm256_setzero_pd();
+
+    int i = 0;
+    __m256d previous = _mm256_set1_pd(p[-1]);
+    __m256d current = _mm256_loadu_pd(p);
+    for(; i + 4 <= n; i += 4)
+    {
+        // the ghost cell p[n] is the last one needed, the lanes after it are not read
+        const __m256d next = i + 8 <= n + 1 ? _mm256_loadu_pd(p + i + 4)
+            : _mm256_maskload_pd(p + i + 4, _mm256_cmpgt_epi64(_mm256_set1_epi64x(n + 1 - (i + 4)), _mm256_setr_epi64x(0, 1, 2, 3)));
+        // (p[i-1], ..., p[i+2]) and (p[i+1], ..., p[i+4])
+        const __m256d left = _mm256_shuffle_pd(_mm256_permute2f128_pd(previous, current, 0x21), current, 0b0101);
+        const __m256d right = _mm256_shuffle_pd(current, _mm256_permute2f128_pd(current, next, 0x21), 0b0101);
+
+        __m256d neighbours = _mm256_mul_pd(_mm256_add_pd(left, right), invDx2);
+        neighbours = _mm256_fmadd_pd(_mm256_add_pd(_mm256_loadu_pd(p + i - sy), _mm256_loadu_pd(p + i + sy)), invDy2, neighbours);
+        neighbours = _mm256_fmadd_pd(_mm256_add_pd(_mm256_loadu_pd(p + i - sz), _mm256_loadu_pd(p + i + sz)), invDz2, neighbours);
+        const __m256d correction = _mm256_fmsub_pd(factor, _mm256_sub_pd(neighbours, _mm256_loadu_pd(rhs + i)), current);
+        const __m256d p_new = _mm256_blendv_pd(current, _mm256_fmadd_pd(omega, correction, current), colour);
+        _mm256_storeu_pd(p + i, p_new);
+        const __m256d colourCorrection = _mm256_and_pd(correction, colour);
+        sum = _mm256_fmadd_pd(colourCorrection, colourCorrection, sum);
+
+        previous = current;
+        current = next;
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, sum);
+    const double correction2 = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    // the remaining cells of the colour, i is even
+    return correction2 + scalarRow(p + i, rhs + i, sy, sz, first, n - i, c);
+}
+
+__attribute__((target("avx512f")))
+static double avx512Row(double *p, const double *rhs, std::ptrdiff_t sy, std::ptrdiff_t sz,
+                        int first, int n, const RedBlackCoefficients &c)
+{
+    const __m512d invDx2 = _mm512_set1_pd(c.invDx2);
+    const __m512d invDy2 = _mm512_set1_pd(c.invDy2);
+    const __m512d invDz2 = _mm512_set1_pd(c.invDz2);
+    const __m512d factor = _mm512_set1_pd(c.factor);
+    const __m512d omega = _mm512_set1_pd(c.omega);
+    const __mmask8 colour = first == 0 ? 0x55 : 0xAA;
+    // lanes of the cells up to the ghost cell p[m] of a vector starting at p[i], m - i < 8
+    auto lanesUpTo = [](int m, int i) { return m - i >= 8 ? (__mmask8)0xFF : (__mmask8)((1u << (m - i + 1)) - 1); };
+    // the unmasked shift and reduction intrinsics of GCC start from an undefined vector, which it warns about,
+    // so the shifts are masked with all lanes and a defined source
+    const __m512i zero = _mm512_setzero_si512();
+    __m512d sum = _mm512_setzero_pd();
+
+    __m512i previous = _mm512_castpd_si512(_mm512_set1_pd(p[-1]));
+    __m512d current = _mm512_maskz_loadu_pd(lanesUpTo(n, 0), p);
+    // the last vector is masked to the end of the row, so it does not read past the rhs
+    for(int i = 0; i < n; i += 8)
+    {
+        const __mmask8 row = n - i >= 8 ? 0xFF : (__mmask8)((1u << (n - i)) - 1);
+        const __mmask8 update = colour & row;
+        const __m512d next = _mm512_maskz_loadu_pd(i + 8 <= n ? lanesUpTo(n, i + 8) : 0, p + i + 8);
+        // (p[i-1], ..., p[i+6]) and (p[i+1], ..., p[i+8])
+        const __m512d left = _mm512_castsi512_pd(_mm512_mask_alignr_epi64(zero, 0xFF, _mm512_castpd_si512(current), previous, 7));
+        const __m512d right = _mm512_castsi512_pd(_mm512_mask_alignr_epi64(zero, 0xFF, _mm512_castpd_si512(next),
+                                                                           _mm512_castpd_si512(current), 1));
+
+        __m512d neighbours = _mm512_mul_pd(_mm512_add_pd(left, right), invDx2);
+        neighbours = _mm512_fmadd_pd(_mm512_add_pd(_mm512_maskz_loadu_pd(row, p + i - sy),
+                                                   _mm512_maskz_loadu_pd(row, p + i + sy)), invDy2, neighbours);
+        neighbours = _mm512_fmadd_pd(_mm512_add_pd(_mm512_maskz_loadu_pd(row, p + i - sz),
+                                                   _mm512_maskz_loadu_pd(row, p + i + sz)), invDz2, neighbours);
+        const __m512d correction = _mm512_fmsub_pd(factor, _mm512_sub_pd(neighbours, _mm512_maskz_loadu_pd(row, rhs + i)),
+                                                   current);
+        const __m512d p_new = _mm512_mask_mov_pd(current, update, _mm512_fmadd_pd(omega, correction, current));
+        _mm512_mask_storeu_pd(p + i, update, p_new);
+        const __m512d colourCorrection = _mm512_maskz_mov_pd(update, correction);
+        sum = _mm512_fmadd_pd(colourCorrection, colourCorrection, sum);
+
+        previous = _mm512_castpd_si512(current);
+        current = next;
+    }
+    double lanes[8];
+    _mm512_storeu_pd(lanes, sum);
+    return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+}
+#endif
+
+RedBlackRowKernel select()
+{
+    #ifdef RED_BLACK_X86
+    if(__builtin_cpu_supports("avx512f"))
+        return avx512Row;
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return avx2Row;
+    #endif
+    return scalarRow;
+}
+
+std::string selectedName()
+{
+    const RedBlackRowKernel kernel = select();
+    for(const auto &candidate : available())
+        if(candidate.second == kernel)
+            return candidate.first;
+    return "scalar";
+}
+
+std::vector<std::pair<std::string, RedBlackRowKernel>> available()
+{
+    std::vector<std::pair<std::string, RedBlackRowKernel>> kernels{{"scalar", scalarRow}};
+    #ifdef RED_BLACK_X86
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        kernels.emplace_back("AVX2", avx2Row);
+    if(__builtin_cpu_supports("avx512f"))
+        kernels.emplace_back("AVX-512", avx512Row);
+    #endif
+    return kernels;
+}
+
+}
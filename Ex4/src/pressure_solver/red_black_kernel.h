@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+//! constants of the over-relaxed 7-point stencil, which are the same for all rows of a sweep
+struct RedBlackCoefficients
+{
+    double invDx2;
+    double invDy2;
+    double invDz2;
+    //! 1 / (2/dx2 + 2/dy2 + 2/dz2)
+    double factor;
+    double omega;
+};
+
+//! Relaxes the cells i = first, first+2, ... < n of one row of p and returns the sum of their squared corrections
+//! (the residuum scaled by -factor). p points to cell 0 of the row and has the neighbours at ±1, ±sy and ±sz,
+//! including the ghost layers, rhs points to cell 0 of the same row of the rhs.
+using RedBlackRowKernel = double (*)(double *p, const double *rhs, std::ptrdiff_t sy, std::ptrdiff_t sz,
+                                     int first, int n, const RedBlackCoefficients &c);
+
+//! A red-black row has a stride of 2, which the compiler does not vectorize. The SIMD kernels instead relax all
+//! cells of the row in contiguous vectors and only store the lanes of the colour (blended with AVX2, masked with
+//! AVX-512): the cells of the other colour are the neighbours in x and are not changed by this colour anyway.
+//! Half of the arithmetic is wasted, but the row is loaded once with unit stride instead of gathered.
+namespace RedBlackKernel
+{
+    //! relaxes the cell p[0] and returns its squared correction, inlined for single cells, e.g. at the faces of the shell
+    inline double cell(double *p, const double *rhs, std::ptrdiff_t sy, std::ptrdiff_t sz, const RedBlackCoefficients &c)
+    {
+        const double p_last = p[0];
+        const double p_corretion = c.factor * ((p[-1] + p[1]) * c.invDx2 + (p[-sy] + p[sy]) * c.invDy2
+                                             + (p[-sz] + p[sz]) * c.invDz2 - rhs[0]) - p_last;
+        p[0] = p_last + c.omega * p_corretion;
+        return p_corretion * p_corretion;
+    }
+
+    //! the plain strided loop, used if the CPU has no AVX2 and for the remaining cells of the AVX2 rows
+    double scalarRow(double *p, const double *rhs, std::ptrdiff_t sy, std::ptrdiff_t sz,
+                     int first, int n, const RedBlackCoefficients &c);
+
+    //! the fastest kernel the CPU supports, checked at runtime
+    RedBlackRowKernel select();
+
+    //! name of the kernel returned by select
+    std::string selectedName();
+
+    //! all kernels the CPU supports with their names, the scalar one first, used by the benchmark
+    std::vector<std::pair<std::string, RedBlackRowKernel>> available();
+}
@@ -1,9 +1,11 @@
 #include "pressure_solver/sor.h"
 
 SOR::SOR(std::shared_ptr<PartitionShell> partition, 
-         double epsilon, int maximumNumberOfIterations, double omega) :
+         double epsilon, int maximumNumberOfIterations, double omega, bool autoOmega) :
          PressureSolver(partition, epsilon, maximumNumberOfIterations),
-         omega_(omega)
+         omega_(omega), autoOmega_(autoOmega),
+         omegaTuner_(partition->pi_, discretization_->dx2(), discretization_->dy2(), discretization_->dz2(), "SOR"),
+         correctionPlane_({discretization_->piN()+1, discretization_->pjN()+1}, "sor.correctionPlane")
 {
     // Other omegas are likely to lead to instability
     // This is user facing, so a nice debug message is more approriate,
@@ -14,6 +16,9 @@ SOR::SOR(std::shared_ptr<PartitionShell> partition,
         str << "Omega may only be 0.0 < "  << omega << " < 2.0!\n";
         throw std::out_of_range(str.str());
     }
+    providesSweepResiduum_ = true;
+    if(autoOmega_)
+        omega_ = omegaTuner_.initialOmega();
 }
 
 // inlining for virtual methods compiles, the hope is,
@@ -26,7 +31,16 @@ inline void SOR::step()
     const double dy2 = discretization_->dy2();
     const double dz2 = discretization_->dz2();
     const double factor = (dx2 * dy2 * dz2) / (2. * (dy2*dz2+dx2*dz2+dx2*dy2));
+    const Array3DView p = discretization_->pView(), b = discretization_->rhsView();
 
+    // the contraction of the last solve is evaluated before omega is used by any rank in this solve
+    if(autoOmega_ && iteration_ == 0)
+        omega_ = omegaTuner_.adapt(omega_);
+
+    // The correction is the residuum scaled by -factor, but the lower neighbours were already updated.
+    // Adding their change back recovers the residuum of the iterate the sweep started from for free.
+    std::fill(correctionPlane_.data(), correctionPlane_.data() + correctionPlane_.length(), 0.0);
+    double residuum2 = 0.0;
     for(int k = 0; k < discretization_->pkN(); k++)
     {
         for(int j = 0; j < discretization_->pjN(); j++)
@@ -34,20 +48,28 @@ inline void SOR::step()
             for(int i = 0; i < discretization_->piN(); i++)
             {
                 // store all variables with short name for readibilty
-                const double p_last = discretization_->p(i,j,k);
-                const double p_xm   = discretization_->p(i-1,j,k);
-                const double p_xp   = discretization_->p(i+1,j,k);
-                const double p_ym   = discretization_->p(i,j-1,k);
-                const double p_yp   = discretization_->p(i,j+1,k);
-                const double p_zm   = discretization_->p(i,j,k-1);
-                const double p_zp   = discretization_->p(i,j,k+1);
-                const double rhs    = discretization_->rhs(i,j,k);
+                const double p_last = p(i,j,k);
+                const double p_xm   = p(i-1,j,k);
+                const double p_xp   = p(i+1,j,k);
+                const double p_ym   = p(i,j-1,k);
+                const double p_yp   = p(i,j+1,k);
+                const double p_zm   = p(i,j,k-1);
+                const double p_zp   = p(i,j,k+1);
+                const double rhs    = b(i,j,k);
 
                 const double p_corretion = factor * ((p_xm+p_xp)/dx2 + (p_ym+p_yp)/dy2 + (p_zm+p_zp)/dz2 - rhs) - p_last;
 
                 const double p_new = p_last + omega_ * p_corretion;
-                discretization_->p(i,j,k) = p_new;
+                p(i,j,k) = p_new;
+
+                const double res_last = -p_corretion / factor + correctionPlane_(i,j+1) / dx2 
+                                      + correctionPlane_(i+1,j) / dy2 + correctionPlane_(i+1,j+1) / dz2;
+                correctionPlane_(i+1,j+1) = p_new - p_last;
+                residuum2 += res_last * res_last;
             }
         }
     }
+    sweepResiduum2_ = residuum2;
+    if(autoOmega_)
+        omegaTuner_.record(iteration_, residuum2);
 }
\ No newline at end of file
@@ -2,18 +2,29 @@
 
 #include <memory>
 #include <cmath>
+#include <algorithm>
 #include <exception>
 #include <sstream>
 #include <mpi.h>
 #include "pressure_solver/pressure_solver.h"
+#include "pressure_solver/auto_omega.h"
 #include "discretization/discretization.h"
 #include "storage/field_variable.h"
+#include "storage/array2D.h"
 
 class SOR : public PressureSolver
 {
 public:
-    SOR(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations, double omega);
+    //! with autoOmega, omega is replaced by the optimum of the grid and adapted to the observed contraction
+    SOR(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations, double omega,
+        bool autoOmega = false);
     void step() override;
 protected:
-    const double omega_;
+    double omega_;
+    const bool autoOmega_;
+    AutoOmega omegaTuner_;
+
+    //! change of the cells in the last plane, used to recover the residuum of the iterate before the sweep,
+    //! shifted by one, so the ghost cells are 0
+    Array2D correctionPlane_;
 };
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include "pressure_solver/subdomain_poisson.h"
+
+SubdomainPoisson::SubdomainPoisson(const PartitionInformation &pi, double dx2, double dy2, double dz2) :
+                                   SubdomainPoisson(pi.nCellsLocal(),
+                                                    {pi.ownLeftBoundary(), pi.ownBottomBoundary(), pi.ownHindBoundary()},
+                                                    {pi.ownRightBoundary(), pi.ownTopBoundary(), pi.ownFrontBoundary()},
+                                                    {dx2, dy2, dz2})
+{
+}
+
+SubdomainPoisson::SubdomainPoisson(std::array<int, 3> nCells, double dx2, double dy2, double dz2) :
+                                   SubdomainPoisson(nCells, {true, true, true}, {true, true, true}, {dx2, dy2, dz2})
+{
+}
+
+SubdomainPoisson::SubdomainPoisson(std::array<int, 3> nCells, std::array<bool, 3> lowerWall, std::array<bool, 3> upperWall,
+                                   std::array<double, 3> h2) :
+                                   n_(nCells)
+{
+    int maximumLength = 0;
+    for(int d = 0; d < 3; d++)
+    {
+        if(lowerWall[d] && upperWall[d])
+            sides_[d] = Sides::WallWall;
+        else if(lowerWall[d])
+            sides_[d] = Sides::WallNeighbour;
+        else if(upperWall[d])
+            sides_[d] = Sides::NeighbourWall;
+        else
+            sides_[d] = Sides::NeighbourNeighbour;
+
+        // mirrored at the wall, the line has Dirichlet faces on both ends, its solution is symmetric
+        const bool mirrored = sides_[d] == Sides::WallNeighbour || sides_[d] == Sides::NeighbourWall;
+        m_[d] = mirrored ? 2 * n_[d] : n_[d];
+        maximumLength = std::max(maximumLength, m_[d]);
+        dct_[d] = std::make_shared<DCT>(m_[d]);
+
+        // cosine modes start with the constant one, the sine modes with half a wave
+        const int shift = (sides_[d] == Sides::WallWall) ? 0 : 1;
+        eigenvalues_[d].resize(m_[d]);
+        for(int t = 0; t < m_[d]; t++)
+        {
+            const double s = std::sin(M_PI * (t + shift) / (2. * m_[d]));
+            eigenvalues_[d][t] = 4. * s * s / h2[d];
+        }
+    }
+
+    buffer_.resize(m_[0] * m_[1] * m_[2]);
+    line_.resize(maximumLength);
+    extended_.resize(maximumLength);
+}
+
+void SubdomainPoisson::solve(FieldVariable &source, FieldVariable &target)
+{
+    const std::array<int, 3> stride{1, m_[0], m_[0] * m_[1]};
+    for(int k = 0; k < n_[2]; k++)
+        for(int j = 0; j < n_[1]; j++)
+            for(int i = 0; i < n_[0]; i++)
+                buffer_[i*stride[0] + j*stride[1] + k*stride[2]] = source(i+1,j+1,k+1);
+
+    // the directions are transformed one after the other, the ones already transformed have m_ entries
+    std::array<int, 3> extent = n_;
+    for(int pass = 0; pass < 6; pass++)
+    {
+        const bool forwardPass = pass < 3;
+        const int d = forwardPass ? pass : 5 - pass;
+        const int e1 = (d == 0) ? 1 : 0;
+        const int e2 = (d == 2) ? 1 : 2;
+        const int lengthIn = forwardPass ? n_[d] : m_[d];
+        const int lengthOut = forwardPass ? m_[d] : n_[d];
+        for(int b = 0; b < extent[e2]; b++)
+        {
+            for(int a = 0; a < extent[e1]; a++)
+            {
+                double *begin = buffer_.data() + a*stride[e1] + b*stride[e2];
+                for(int t = 0; t < lengthIn; t++)
+                    line_[t] = begin[t*stride[d]];
+                if(forwardPass)
+                    forward(d, line_.data(), line_.data());
+                else
+                    backward(d, line_.data(), line_.data());
+                for(int t = 0; t < lengthOut; t++)
+                    begin[t*stride[d]] = line_[t];
+            }
+        }
+        extent[d] = lengthOut;
+
+        if(pass == 2)
+        {
+            // the constant mode only exists if all sides are walls, it is the free constant of the Neumann problem
+            for(int k = 0; k < m_[2]; k++)
+            {
+                for(int j = 0; j < m_[1]; j++)
+                {
+                    for(int i = 0; i < m_[0]; i++)
+                    {
+                        const double eigenvalue = eigenvalues_[0][i] + eigenvalues_[1][j] + eigenvalues_[2][k];
+                        double &mode = buffer_[i*stride[0] + j*stride[1] + k*stride[2]];
+                        mode = (eigenvalue == 0.0) ? 0.0 : mode / eigenvalue;
+                    }
+                }
+            }
+        }
+    }
+
+    for(int k = 0; k < n_[2]; k++)
+        for(int j = 0; j < n_[1]; j++)
+            for(int i = 0; i < n_[0]; i++)
+                target(i+1,j+1,k+1) = buffer_[i*stride[0] + j*stride[1] + k*stride[2]];
+}
+
+void SubdomainPoisson::forward(int d, const double *line, double *coefficients)
+{
+    const int n = n_[d];
+    const int m = m_[d];
+    if(sides_[d] == Sides::WallWall)
+    {
+        std::copy(line, line + n, extended_.begin());
+        dct_[d]->forward(extended_.data());
+        std::copy(extended_.begin(), extended_.begin() + m, coefficients);
+        return;
+    }
+
+    for(int t = 0; t < n; t++)
+    {
+        if(sides_[d] == Sides::WallNeighbour)
+        {
+            extended_[n-1-t] = line[t];
+            extended_[n+t] = line[t];
+        }
+        else if(sides_[d] == Sides::NeighbourWall)
+        {
+            extended_[t] = line[t];
+            extended_[m-1-t] = line[t];
+        }
+        else
+            extended_[t] = line[t];
+    }
+    // sine transform of type II: the cosine transform of the alternating line in reversed order
+    for(int t = 1; t < m; t += 2)
+        extended_[t] = -extended_[t];
+    dct_[d]->forward(extended_.data());
+    for(int t = 0; t < m; t++)
+        coefficients[t] = extended_[m-1-t];
+}
+
+void SubdomainPoisson::backward(int d, const double *coefficients, double *line)
+{
+    const int n = n_[d];
+    const int m = m_[d];
+    if(sides_[d] == Sides::WallWall)
+    {
+        std::copy(coefficients, coefficients + m, extended_.begin());
+        dct_[d]->backward(extended_.data());
+        std::copy(extended_.begin(), extended_.begin() + n, line);
+        return;
+    }
+
+    for(int t = 0; t < m; t++)
+        extended_[t] = coefficients[m-1-t];
+    dct_[d]->backward(extended_.data());
+    for(int t = 1; t < m; t += 2)
+        extended_[t] = -extended_[t];
+    // the solution of the mirrored line is symmetric, the half of the partition is kept
+    const int first = (sides_[d] == Sides::WallNeighbour) ? n : 0;
+    std::copy(extended_.begin() + first, extended_.begin() + first + n, line);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <sstream>
+#include "pressure_solver/dct.h"
+#include "discretization/partition_information.h"
+#include "storage/field_variable.h"
+
+//! Direct solver of the negative laplacian on the partition alone, the diagonal block of a block-Jacobi
+//! (non-overlapping additive Schwarz) preconditioner. The walls keep their homogeneous Neumann condition,
+//! the faces to the neighbours get a homogeneous Dirichlet condition, so each direction is diagonalized by
+//! a cosine transform (wall-wall), a sine transform (neighbour-neighbour) or the sine transform of the line
+//! mirrored at its wall (wall-neighbour), all of them are calculated with the DCT.
+//! One solve costs O(N log N) and needs no communication.
+class SubdomainPoisson
+{
+public:
+    SubdomainPoisson(const PartitionInformation &pi, double dx2, double dy2, double dz2);
+
+    //! solver of a whole box of cells surrounded by walls, e.g. a grid gathered on one rank
+    SubdomainPoisson(std::array<int, 3> nCells, double dx2, double dy2, double dz2);
+
+    //! solves -Δ target = source on the partition, both fields are indexed including their ghost layer,
+    //! the ghost layers are ignored, if all sides are walls the constant mode of target is 0
+    void solve(FieldVariable &source, FieldVariable &target);
+
+protected:
+    SubdomainPoisson(std::array<int, 3> nCells, std::array<bool, 3> lowerWall, std::array<bool, 3> upperWall,
+                     std::array<double, 3> h2);
+
+    //! boundary conditions of a direction, lower side first
+    enum class Sides
+    {
+        WallWall,
+        NeighbourNeighbour,
+        WallNeighbour,
+        NeighbourWall
+    };
+
+    //! transforms the local line of length n into the m_ coefficients of its direction and back
+    void forward(int d, const double *line, double *coefficients);
+    void backward(int d, const double *coefficients, double *line);
+
+    std::array<int, 3> n_;
+    //! number of coefficients of each direction, the mirrored lines have twice the length
+    std::array<int, 3> m_;
+    std::array<Sides, 3> sides_;
+    std::array<std::shared_ptr<DCT>, 3> dct_;
+    //! eigenvalues of the 1D negative laplacians
+    std::array<std::vector<double>, 3> eigenvalues_;
+
+    //! coefficients of the partition in the order i, j, k, with m_ entries in each direction
+    std::vector<double> buffer_;
+    std::vector<double> line_;
+    std::vector<double> extended_;
+};
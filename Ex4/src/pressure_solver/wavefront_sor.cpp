@@ -0,0 +1,133 @@
+#include "pressure_solver/wavefront_sor.h"
+
+WavefrontSOR::WavefrontSOR(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations, double omega,
+                           int sweepsPerStep, bool redBlack) :
+                           PressureSolver(partition, epsilon, maximumNumberOfIterations),
+                           omega_(omega), sweeps_(sweepsPerStep), redBlack_(redBlack), nStages_(redBlack ? 2*sweepsPerStep : sweepsPerStep),
+                           parityOffset_((partition->pi_.nodeOffset()[0] + partition->pi_.nodeOffset()[1]
+                                        + partition->pi_.nodeOffset()[2]) & 0b1),
+                           correctionPlane_({discretization_->piN()+1, discretization_->pjN()+1}, "wavefront.correctionPlane")
+{
+    if(omega <= 0.0 || omega >= 2.0)
+    {
+        std::stringstream str;
+        str << "Omega may only be 0.0 < "  << omega << " < 2.0!\n";
+        throw std::out_of_range(str.str());
+    }
+    if(sweepsPerStep < 1)
+    {
+        std::stringstream str;
+        str << "The wavefront needs at least 1 sweep per step, but got " << sweepsPerStep << "!\n";
+        throw std::out_of_range(str.str());
+    }
+    const PartitionInformation &pi = partition_->pi_;
+    lowerWall_ = {pi.ownLeftBoundary(), pi.ownBottomBoundary(), pi.ownHindBoundary()};
+    upperWall_ = {pi.ownRightBoundary(), pi.ownTopBoundary(), pi.ownFrontBoundary()};
+    providesSweepResiduum_ = true;
+}
+
+void WavefrontSOR::step()
+{
+    const int kN = discretization_->pkN();
+    std::fill(correctionPlane_.data(), correctionPlane_.data() + correctionPlane_.length(), 0.0);
+
+    // the stages are processed in ascending order within each wavefront, stage s-1 has already
+    // relaxed plane k+1, when stage s relaxes plane k
+    double residuum2 = 0.0;
+    for(int wave = 0; wave < kN + nStages_ - 1; wave++)
+    {
+        for(int stage = std::max(0, wave - kN + 1); stage <= std::min(wave, nStages_ - 1); stage++)
+        {
+            const int k = wave - stage;
+            residuum2 += relaxPlane(k, stage);
+            setWallGhosts(k);
+        }
+    }
+    sweepResiduum2_ = residuum2;
+}
+
+double WavefrontSOR::relaxPlane(int k, int stage)
+{
+    const double dx2 = discretization_->dx2();
+    const double dy2 = discretization_->dy2();
+    const double dz2 = discretization_->dz2();
+    const double factor = (dx2 * dy2 * dz2) / (2. * (dy2*dz2+dx2*dz2+dx2*dy2));
+    const double wx = factor / dx2;
+    const double wy = factor / dy2;
+    const double wz = factor / dz2;
+    const bool lastSweep = stage >= nStages_ - (redBlack_ ? 2 : 1);
+    const int iStep = redBlack_ ? 2 : 1;
+
+    // the wavefront only pays off, if the sweep is bound by the memory traffic and not by the calls of the accessors,
+    // so the rows are addressed directly, p is stored with its ghost layer, rhs without
+    FieldVariable &p = discretization_->p();
+    FieldVariable &rhs = discretization_->rhs();
+    const std::size_t strideY = p.size()[0];
+    const std::size_t strideZ = p.size()[0] * p.size()[1];
+
+    double residuum2 = 0.0;
+    for(int j = 0; j < discretization_->pjN(); j++)
+    {
+        double *pRow = p.data() + p.compute_index(1, j+1, k+1);
+        const double *rhsRow = rhs.data() + rhs.compute_index(0, j, k);
+        // red cells have an even global index sum, in lexicographic order all cells are relaxed
+        const int i0 = redBlack_ ? ((j + k + parityOffset_ + stage) & 0b1) : 0;
+        for(int i = i0; i < discretization_->piN(); i += iStep)
+        {
+            const double p_last = pRow[i];
+            const double p_corretion = wx * (pRow[i-1] + pRow[i+1]) + wy * (pRow[i-strideY] + pRow[i+strideY])
+                                     + wz * (pRow[i-strideZ] + pRow[i+strideZ]) - factor * rhsRow[i] - p_last;
+
+            const double p_new = p_last + omega_ * p_corretion;
+            pRow[i] = p_new;
+
+            if(!lastSweep)
+                continue;
+            if(redBlack_)
+            {
+                // estimate like in Checkerboard
+                residuum2 += p_corretion * p_corretion / (factor * factor);
+            }
+            else
+            {
+                // the planes of the last stage are relaxed in ascending order, so the correction plane works like in SOR
+                const double res_last = -p_corretion / factor + correctionPlane_(i,j+1) / dx2
+                                      + correctionPlane_(i+1,j) / dy2 + correctionPlane_(i+1,j+1) / dz2;
+                correctionPlane_(i+1,j+1) = p_new - p_last;
+                residuum2 += res_last * res_last;
+            }
+        }
+    }
+    return residuum2;
+}
+
+void WavefrontSOR::setWallGhosts(int k)
+{
+    const int iN = discretization_->piN();
+    const int jN = discretization_->pjN();
+    const int kN = discretization_->pkN();
+    const Array3DView p = discretization_->pView();
+
+    for(int j = 0; j < jN; j++)
+    {
+        if(lowerWall_[0])
+            p(-1,j,k) = p(0,j,k);
+        if(upperWall_[0])
+            p(iN,j,k) = p(iN-1,j,k);
+    }
+    for(int i = 0; i < iN; i++)
+    {
+        if(lowerWall_[1])
+            p(i,-1,k) = p(i,0,k);
+        if(upperWall_[1])
+            p(i,jN,k) = p(i,jN-1,k);
+    }
+    if(k == 0 && lowerWall_[2])
+        for(int j = 0; j < jN; j++)
+            for(int i = 0; i < iN; i++)
+                p(i,j,-1) = p(i,j,0);
+    if(k == kN-1 && upperWall_[2])
+        for(int j = 0; j < jN; j++)
+            for(int i = 0; i < iN; i++)
+                p(i,j,kN) = p(i,j,kN-1);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+#include <array>
+#include <cmath>
+#include <algorithm>
+#include <exception>
+#include <sstream>
+#include <mpi.h>
+#include "pressure_solver/pressure_solver.h"
+#include "discretization/discretization.h"
+#include "discretization/partition_shell.h"
+#include "storage/field_variable.h"
+#include "storage/array2D.h"
+
+//! SOR or red-black SOR with temporal blocking: one step does several sweeps in a single pass over the z-planes.
+//! The sweeps (and colours) are stages of a pipelined wavefront, at wavefront w the stage s relaxes the plane w-s,
+//! so each stage finds the lower plane already at its own stage and the upper one at the previous stage,
+//! which is exactly the Gauss-Seidel order of consecutive sweeps. Only the nStages+2 planes around the wavefront
+//! are touched at once, so p and rhs are streamed from memory once per step instead of once per sweep.
+//! The Neumann ghost cells of the walls are updated plane by plane, so on one rank a step is identical to sweeps
+//! steps of SOR; between partitions the halo is only exchanged once per step, like for the deep halo checkerboard.
+class WavefrontSOR : public PressureSolver
+{
+public:
+    //! redBlack relaxes both colours as separate stages instead of the lexicographic order of SOR
+    WavefrontSOR(std::shared_ptr<PartitionShell> partition, double epsilon, int maximumNumberOfIterations, double omega,
+                 int sweepsPerStep, bool redBlack);
+
+    //! sweepsPerStep sweeps, the residuum of the last sweep is summed up like in SOR respectively Checkerboard
+    void step() override;
+
+protected:
+    //! relaxes the cells of plane k, which belong to stage, returns the squared residuum if it is the last sweep
+    double relaxPlane(int k, int stage);
+
+    //! copies the cells of plane k onto the ghost cells of the own walls
+    void setWallGhosts(int k);
+
+    const double omega_;
+    const int sweeps_;
+    const bool redBlack_;
+    //! one stage per sweep for SOR, two for red-black
+    const int nStages_;
+    //! parity of the global index of the first cell of the partition
+    const int parityOffset_;
+    //! if the partition has a wall instead of a neighbour on the lower and upper side of each direction
+    std::array<bool, 3> lowerWall_;
+    std::array<bool, 3> upperWall_;
+
+    //! change of the cells in the last plane of the last sweep, see SOR
+    Array2D correctionPlane_;
+};
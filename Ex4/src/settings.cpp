@@ -155,15 +155,55 @@ void Settings::setParameter(const std::string &name, const std::string &value) {
     pressureSolver = value;
   } else if (name == "omega") {
     omega = std::stod(value);
+  } else if (name == "autoOmega") {
+    autoOmega = (value == "true" || value == "1");
+  } else if (name == "preconditioner") {
+    preconditioner = value;
   } else if (name == "epsilon") {
     epsilon = std::stod(value);
   } else if (name == "maximumNumberOfIterations") {
     // double should be able to convert numbers with e, int is not
     maximumNumberOfIterations = (int)std::stod(value);
+  } else if (name == "residuumCheckInterval") {
+    residuumCheckInterval = std::stoi(value);
+  } else if (name == "useSweepResiduum") {
+    useSweepResiduum = (value == "true" || value == "1");
+  } else if (name == "useNonBlockingResiduum") {
+    useNonBlockingResiduum = (value == "true" || value == "1");
+  } else if (name == "pressureExtrapolationOrder") {
+    pressureExtrapolationOrder = std::stoi(value);
+  } else if (name == "useMixedPrecision") {
+    useMixedPrecision = (value == "true" || value == "1");
+  } else if (name == "mixedPrecisionInnerIterations") {
+    mixedPrecisionInnerIterations = std::stoi(value);
   } else if (name == "disableAdaptiveDt") {
     disableAdaptiveDt = (value == "true" || value == "1");
   } else if (name == "useAsyncComm") {
     useAsyncComm = (value == "true" || value == "1");
+  } else if (name == "useDatatypeHalos") {
+    useDatatypeHalos = (value == "true" || value == "1");
+  } else if (name == "usePersistentComm") {
+    usePersistentComm = (value == "true" || value == "1");
+  } else if (name == "useNeighbourCollectives") {
+    useNeighbourCollectives = (value == "true" || value == "1");
+  } else if (name == "useOverlappedComm") {
+    useOverlappedComm = (value == "true" || value == "1");
+  } else if (name == "useFusedKernels") {
+    useFusedKernels = (value == "true" || value == "1");
+  } else if (name == "wavefrontSweeps") {
+    wavefrontSweeps = std::stoi(value);
+  } else if (name == "lineDirection") {
+    lineDirection = std::stoi(value);
+  } else if (name == "haloDepth") {
+    haloDepth = std::stoi(value);
+  } else if (name == "multigridMaxLevels") {
+    multigridMaxLevels = std::stoi(value);
+  } else if (name == "multigridSmoothingSteps") {
+    multigridSmoothingSteps = std::stoi(value);
+  } else if (name == "multigridCoarseIterations") {
+    multigridCoarseIterations = std::stoi(value);
+  } else if (name == "chebyshevLowerBoundFraction") {
+    chebyshevLowerBoundFraction = std::stod(value);
   } else {
     std::cout << "Unknown parameter: " << name << std::endl;
   }
@@ -204,10 +244,32 @@ void Settings::printSettings()
             << ", alpha: " << alpha << std::endl
 
             << "  pressureSolver: " << pressureSolver << ", omega: " << omega
+            << ", autoOmega: " << std::boolalpha << autoOmega
+            << ", preconditioner: " << preconditioner
             << ", epsilon: " << epsilon
             << ", maximumNumberOfIterations: " << maximumNumberOfIterations
+            << ", residuumCheckInterval: " << residuumCheckInterval
+            << ", useSweepResiduum: " << std::boolalpha << useSweepResiduum
+            << ", useNonBlockingResiduum: " << std::boolalpha << useNonBlockingResiduum
+            << ", pressureExtrapolationOrder: " << pressureExtrapolationOrder
+            << ", useMixedPrecision: " << std::boolalpha << useMixedPrecision
+            << ", mixedPrecisionInnerIterations: " << mixedPrecisionInnerIterations
 
             << "  disableAdaptiveDt: " << std::boolalpha << disableAdaptiveDt
             << "  useAsyncComm: " << std::boolalpha << useAsyncComm
+            << ", useDatatypeHalos: " << std::boolalpha << useDatatypeHalos
+            << ", usePersistentComm: " << std::boolalpha << usePersistentComm
+            << ", useNeighbourCollectives: " << std::boolalpha << useNeighbourCollectives
+            << ", useOverlappedComm: " << std::boolalpha << useOverlappedComm
+            << ", useFusedKernels: " << std::boolalpha << useFusedKernels
+            << ", wavefrontSweeps: " << wavefrontSweeps
+            << ", lineDirection: " << lineDirection
+            << ", haloDepth: " << haloDepth
+            << std::endl
+
+            << "  multigridMaxLevels: " << multigridMaxLevels
+            << ", multigridSmoothingSteps: " << multigridSmoothingSteps
+            << ", multigridCoarseIterations: " << multigridCoarseIterations
+            << ", chebyshevLowerBoundFraction: " << chebyshevLowerBoundFraction
             << std::endl;
 }
@@ -37,12 +37,32 @@ struct Settings
     std::array<double, 3>
         dirichletBcHind{0., 0., 0.};
     std::string pressureSolver =
-        "Checkerboard";          //< which pressure solver to use, "GaussSeidel" or "SOR"
+        "Checkerboard";          //< which pressure solver to use, "GaussSeidel", "SOR", "Checkerboard", "Multigrid", "CG", "PCG", "MGCG", "PipelinedCG", "Chebyshev", "WavefrontSOR", "WavefrontCheckerboard", "LineSOR", "BlockJacobi" or "FFT"
     double omega = 1.6; //< overrelaxation factor
+    bool autoOmega = false; //< SOR, Checkerboard and DeepHaloCheckerboard choose omega from the grid and adapt it to the observed contraction
+    std::string preconditioner = "SSOR"; //< PCG and PipelinedCG preconditioner, "None", "Jacobi", "SymmetricGaussSeidel", "SSOR", "Subdomain" or "Multigrid" (PCG only, same as MGCG)
     double epsilon = 1e-5; //< tolerance for the residual in the pressure solver
     int maximumNumberOfIterations =
         1e4; //< maximum number of iterations in the solver
+    int residuumCheckInterval = 1; //< the solver residuum is only checked after every residuumCheckInterval steps
+    bool useSweepResiduum = false; //< SOR, GaussSeidel and Checkerboard check the residuum summed up during their sweep
+    bool useNonBlockingResiduum = false; //< the residuum reduction is overlapped with the next solver step
+    int pressureExtrapolationOrder = 0; //< initial guess of the pressure solver extrapolated from the last solutions, 0 (off), 1 (linear) or 2 (quadratic)
+    bool useMixedPrecision = false; //< SOR and Checkerboard relax a correction in single precision, refined in double
+    int mixedPrecisionInnerIterations = 4; //< single precision sweeps per refinement step of the mixed precision solver
     bool useAsyncComm = true; //< If asynchronous MPI communication is to be used
+    bool useDatatypeHalos = false; //< the halos of p, u, v, w, f, g and h are sent and received in place with MPI datatypes instead of packed buffers
+    bool usePersistentComm = false; //< the halo exchanges restart persistent MPI requests instead of posting new ones
+    bool useNeighbourCollectives = false; //< the halos of p, u, v, w, f, g and h are exchanged with one MPI_Ineighbor_alltoallw per field on the Cartesian communicator, takes precedence over useDatatypeHalos
+    bool useOverlappedComm = false; //< F, G, H, the rhs, u, v, w, Checkerboard, Chebyshev, PCG and PipelinedCG exchange their halos, while they calculate the interior of the partition
+    bool useFusedKernels = false; //< F, G, H and the rhs are calculated in one pass, calculateUVW records the velocity maxima for dt
+    int wavefrontSweeps = 4; //< sweeps of WavefrontSOR and WavefrontCheckerboard per pass over the planes
+    int lineDirection = -1; //< direction of the lines of LineSOR, 0, 1 or 2, -1 uses the direction with the smallest mesh width
+    int haloDepth = 1; //< ghost layers of the Checkerboard pressure, an even depth > 1 does depth/2 iterations per halo exchange
+    int multigridMaxLevels = 8;         //< maximum number of grid levels of the multigrid solver
+    int multigridSmoothingSteps = 2;    //< pre- and post-smoothing sweeps on each multigrid level
+    int multigridCoarseIterations = 50; //< red-black sweeps on the coarsest multigrid level, unless it is small enough to be solved on rank 0
+    double chebyshevLowerBoundFraction = 0.0; //< Chebyshev only targets the eigenvalues above this fraction of the largest one, 0 uses the whole spectrum
 
     //! parse a text file with settings, each line contains "<parameterName> =
     //! <value>"
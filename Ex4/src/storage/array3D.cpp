@@ -12,11 +12,8 @@ size_(size), name_(name), size0Xsize1_(size[0]*size[1])
   data_.resize(total_size, 0.0);
 }
 
-inline double &Array3D::operator()(int i, int j, int k)
+void Array3D::checkIndex(int i, int j, int k) const
 {
-  const std::size_t index = compute_index(i, j, k);
-  // make assertion conditional on DEBUG mode to optimize further
-  #ifndef NDEBUG
   if(i < 0 || i >= size_[0] || j < 0 || j >= size_[1] || k < 0 || k >= size_[2])
   {
     int rank;
@@ -26,27 +23,4 @@ inline double &Array3D::operator()(int i, int j, int k)
         << "), size: (" << size_[0] << ',' << size_[1] << ',' << size_[2] << ") in R:" << rank << "\n";
     throw std::out_of_range(str.str());
   }
-  #endif
-
-  return data_[index];
 }
-
-inline double Array3D::operator()(int i, int j, int k) const
-{
-  //std::size_t index = compute_index(i, j, k);
-  const std::size_t index = compute_index(i, j, k);
-  // assert that indices are in range
-  #ifndef NDEBUG
-  if(i < 0 || i >= size_[0] || j < 0 || j >= size_[1] || k < 0 || k >= size_[2])
-  {
-    int rank;
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-    std::stringstream str;
-    str << "Out-of-bound access on " << name_ << "(i,j,k): (" << i << ',' << j << ',' << k
-        << "), size: (" << size_[0] << ',' << size_[1] << ',' << size_[2] << ") in R:" << rank << "\n";
-    throw std::out_of_range(str.str());
-  }
-  #endif
-
-  return data_[index];
-}
\ No newline at end of file
@@ -8,6 +8,15 @@
 #include <exception>
 #include <limits>
 #include <mpi.h>
+#include "storage/array3D_view.h"
+
+// The access is only virtual for the printing accessors of FieldVariable in the discretization tests,
+// otherwise it is inlined into the kernels like the one of FloatArray3D.
+#ifdef DISCRETIZATION_TEST
+#define ARRAY3D_ACCESS virtual
+#else
+#define ARRAY3D_ACCESS
+#endif
 
 /** This class represents a 2D array of double values.
  *  Internally they are stored consecutively in memory.
@@ -36,17 +45,43 @@ public:
   }
 
   // often used items are inlined for better optimisation
-  //! access the value at coordinate (i,j), declared not const, i.e. the value
+  //! access the value at coordinate (i,j,k), declared not const, i.e. the value
   //! can be changed
-  virtual double &operator()(int i, int j, int k);
+  inline ARRAY3D_ACCESS double &operator()(int i, int j, int k)
+  {
+    // make assertion conditional on DEBUG mode to optimize further
+    #ifndef NDEBUG
+    checkIndex(i, j, k);
+    #endif
+    return data_[compute_index(i, j, k)];
+  }
 
-  //! get the value at coordinate (i,j), declared const, i.e. it is not possible
+  //! get the value at coordinate (i,j,k), declared const, i.e. it is not possible
   //! to change the value
-  virtual double operator()(int i, int j, int k) const;
+  inline ARRAY3D_ACCESS double operator()(int i, int j, int k) const
+  {
+    #ifndef NDEBUG
+    checkIndex(i, j, k);
+    #endif
+    return data_[compute_index(i, j, k)];
+  }
+
+  //! raw view for the kernels, (0,0,0) of the view is (i0,j0,k0) of the array
+  inline Array3DView view(int i0 = 0, int j0 = 0, int k0 = 0)
+  {
+    return Array3DView(data_.data(), size_, {i0, j0, k0}, name_);
+  }
+  inline ConstArray3DView view(int i0 = 0, int j0 = 0, int k0 = 0) const
+  {
+    return ConstArray3DView(data_.data(), size_, {i0, j0, k0}, name_);
+  }
 
   inline void rename(std::string name) { name_ = name; }
 
 protected:
+  //! throws, if (i,j,k) is out of bounds
+  void checkIndex(int i, int j, int k) const;
+
   std::vector<double> data_;      //< storage array values, in row-major order
   const std::array<int, 3> size_; //< width, height of the domain
   std::string name_;              //< name used for debugging
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <sstream>
+#include <exception>
+#include <cstddef>
+#include <mpi.h>
+
+/** Non-owning view of the data of an Array3D for the inner loops of the kernels.
+ *  It holds a __restrict base pointer, which already includes the offset of the view's origin
+ *  (e.g. the ghost layers of a staggered field), and the precomputed strides, so an access
+ *  is a single multiply-add without any call. Debug builds check the index against the array.
+ *  A view is only valid as long as the array it was taken from. T is double, float or their const versions.
+ */
+template<typename T>
+class BasicArray3DView
+{
+public:
+  //! view of the array data of the given size, which starts at (i0,j0,k0) of the array
+  BasicArray3DView(T *data, std::array<int, 3> size, std::array<int, 3> origin, const std::string &name) :
+    data_(data + origin[0] + (std::ptrdiff_t)origin[1] * size[0] + (std::ptrdiff_t)origin[2] * size[0] * size[1]),
+    strideY_(size[0]), strideZ_((std::ptrdiff_t)size[0] * size[1])
+    #ifndef NDEBUG
+    , size_(size), origin_(origin), name_(&name)
+    #endif
+  {
+    #ifdef NDEBUG
+    (void)name;
+    #endif
+  }
+
+  //! access the value at (i,j,k) relative to the origin of the view
+  inline T &operator()(int i, int j, int k) const
+  {
+    #ifndef NDEBUG
+    checkIndex(i, j, k);
+    #endif
+    return data_[i + j * strideY_ + k * strideZ_];
+  }
+
+  //! pointer to (i,j,k), for kernels which walk along a row with their own offsets
+  inline T *row(int i, int j, int k) const
+  {
+    #ifndef NDEBUG
+    checkIndex(i, j, k);
+    #endif
+    return data_ + i + j * strideY_ + k * strideZ_;
+  }
+
+  //! distance between two neighbours in y and z direction, the one in x direction is 1
+  inline std::ptrdiff_t strideY() const { return strideY_; }
+  inline std::ptrdiff_t strideZ() const { return strideZ_; }
+
+private:
+  #ifndef NDEBUG
+  //! throws, if (i,j,k) is outside of the array
+  void checkIndex(int i, int j, int k) const
+  {
+    const int ia = i + origin_[0], ja = j + origin_[1], ka = k + origin_[2];
+    if(ia < 0 || ia >= size_[0] || ja < 0 || ja >= size_[1] || ka < 0 || ka >= size_[2])
+    {
+      int rank;
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      std::stringstream str;
+      str << "Out-of-bound access on the view of " << *name_ << "(i,j,k): (" << i << ',' << j << ',' << k
+          << ") with origin (" << origin_[0] << ',' << origin_[1] << ',' << origin_[2]
+          << "), size: (" << size_[0] << ',' << size_[1] << ',' << size_[2] << ") in R:" << rank << "\n";
+      throw std::out_of_range(str.str());
+    }
+  }
+  #endif
+
+  T *__restrict data_;             //< points to the origin of the view
+  const std::ptrdiff_t strideY_;
+  const std::ptrdiff_t strideZ_;
+  #ifndef NDEBUG
+  const std::array<int, 3> size_;
+  const std::array<int, 3> origin_;
+  const std::string *name_;
+  #endif
+};
+
+using Array3DView = BasicArray3DView<double>;
+using ConstArray3DView = BasicArray3DView<const double>;
+using FloatArray3DView = BasicArray3DView<float>;
@@ -0,0 +1,9 @@
+#include "storage/float_array2D.h"
+
+FloatArray2D::FloatArray2D(std::array<int, 2> size, std::string name) : size_(size), name_(name)
+{
+  assert(size[0] > 0);
+  assert(size[1] > 0);
+  // allocate data, initialize to 0
+  data_.resize(size_[0] * size_[1], 0.0f);
+}
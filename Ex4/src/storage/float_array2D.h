@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cassert>
+#include <array>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <exception>
+#include <mpi.h>
+
+/** Same as Array2D, but with single precision values.
+ *  It is used as halo buffer of the mixed precision pressure solver, which halves the message size.
+ */
+class FloatArray2D {
+public:
+  //! optional name argument for debugging convenience
+  FloatArray2D(std::array<int, 2> size, std::string name = "unnamed");
+
+  //! get the size
+  inline std::array<int, 2> size() const { return size_; }
+
+  //! gets the underlying buffer definition
+  inline float* data() { return data_.data(); };
+
+  //! gets the total length
+  inline std::size_t length() const { return data_.size(); }
+
+  //! access the value at coordinate (i,j), declared not const, i.e. the value
+  //! can be changed
+  inline float &operator()(int i, int j)
+  {
+    const int index = j * size_[0] + i;
+    #ifndef NDEBUG
+    if(i < 0 || i >= size_[0] || j < 0 || j >= size_[1])
+    {
+      int rank;
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      std::stringstream str;
+      str << "Out-of-bound access on " << name_ << "(i,j): (" << i << ',' << j
+          << "), size: (" << size_[0] << ',' << size_[1] << ") in R:" << rank << "\n";
+      throw std::out_of_range(str.str());
+    }
+    #endif
+
+    return data_[index];
+  }
+
+  //! get the value at coordinate (i,j), declared const, i.e. it is not possible
+  //! to change the value
+  inline float operator()(int i, int j) const
+  {
+    const int index = j * size_[0] + i;
+    #ifndef NDEBUG
+    if(i < 0 || i >= size_[0] || j < 0 || j >= size_[1])
+    {
+      int rank;
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      std::stringstream str;
+      str << "Out-of-bound access on " << name_ << "(i,j): (" << i << ',' << j
+          << "), size: (" << size_[0] << ',' << size_[1] << ") in R:" << rank << "\n";
+      throw std::out_of_range(str.str());
+    }
+    #endif
+
+    return data_[index];
+  }
+
+  inline void rename(std::string name) { name_ = name; }
+
+protected:
+  std::vector<float> data_;       //< storage array values, in row-major order
+  const std::array<int, 2> size_; //< width, height of the domain
+  std::string name_;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cassert>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <sstream>
+#include <iostream>
+#include <exception>
+#include <mpi.h>
+#include "storage/array3D_view.h"
+
+/** Single precision counterpart of Array3D for fields with the layout of p.
+ *  The access is not virtual, as it is only used in the inner loops of the mixed precision pressure solver.
+ */
+class FloatArray3D {
+public:
+  //! optional name argument for debugging convenience
+  FloatArray3D(std::array<int, 3> size, std::string name = "unnamed");
+
+  //! get the size
+  inline std::array<int, 3> size() const { return size_; }
+
+  //! get the length of the underlying data
+  inline std::size_t length() const { return data_.size(); }
+
+  //! gets the underlying buffer definition
+  inline float* data() { return data_.data(); };
+
+  //! sets all values including the ghost layers to 0
+  inline void setToZero() { std::fill(data_.begin(), data_.end(), 0.0f); }
+
+  //! access the value at coordinate (i,j,k), declared not const, i.e. the value
+  //! can be changed
+  inline float &operator()(int i, int j, int k)
+  {
+    #ifndef NDEBUG
+    checkIndex(i, j, k);
+    #endif
+    return data_[k * size0Xsize1_ + j * size_[0] + i];
+  }
+
+  //! get the value at coordinate (i,j,k), declared const, i.e. it is not possible
+  //! to change the value
+  inline float operator()(int i, int j, int k) const
+  {
+    #ifndef NDEBUG
+    checkIndex(i, j, k);
+    #endif
+    return data_[k * size0Xsize1_ + j * size_[0] + i];
+  }
+
+  //! raw view for the kernels, (0,0,0) of the view is (i0,j0,k0) of the array
+  inline FloatArray3DView view(int i0 = 0, int j0 = 0, int k0 = 0)
+  {
+    return FloatArray3DView(data_.data(), size_, {i0, j0, k0}, name_);
+  }
+
+  inline void rename(std::string name) { name_ = name; }
+
+protected:
+  //! throws, if (i,j,k) is out of bounds
+  void checkIndex(int i, int j, int k) const;
+
+  std::vector<float> data_;       //< storage array values, in row-major order
+  const std::array<int, 3> size_; //< width, height, depth of the domain
+  std::string name_;              //< name used for debugging
+  const std::size_t size0Xsize1_; //< precomputed size of the cube area for efficiency
+};
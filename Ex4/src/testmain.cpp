@@ -1,6 +1,9 @@
 #include <iostream>
 #include <array>
+#include <vector>
 #include <memory>
+#include <cmath>
+#include <algorithm>
 #include <mpi.h>
 #include "storage/field_variable.h"
 #include "discretization/partition_information.h"
@@ -8,6 +11,7 @@
 #include "discretization/discretization.h"
 #include "discretization/central_differences.h"
 #include "discretization/async_partition.h"
+#include "pressure_solver/dct.h"
 
 // setup with "cmake .. -DTEST=1"
 
@@ -40,6 +44,41 @@ void test_field_variable()
     }
 }
 
+void test_dct()
+{
+    // the scaling of the forward transform depends on the build, so it is checked on the cosine modes, which it maps
+    // to a single wave number, and with the round trip. The lengths cover the radix 2 butterfly and other prime factors.
+    for(int n : {1, 2, 7, 12, 30, 31})
+    {
+        DCT dct(n);
+        std::vector<double> line(n);
+        double modeError = 0.0;
+        for(int mode = 0; mode < n; mode++)
+        {
+            for(int j = 0; j < n; j++)
+                line[j] = std::cos(M_PI * mode * (j + 0.5) / n);
+            dct.forward(line.data());
+            for(int k = 0; k < n; k++)
+            {
+                if(k != mode)
+                    modeError = std::max(modeError, std::abs(line[k]) / std::abs(line[mode]));
+            }
+        }
+
+        std::vector<double> original(n);
+        for(int j = 0; j < n; j++)
+            original[j] = line[j] = std::sin(1.3 * j + 0.4) + 0.1 * j;
+        dct.forward(line.data());
+        dct.backward(line.data());
+        double roundTripError = 0.0;
+        for(int j = 0; j < n; j++)
+            roundTripError = std::max(roundTripError, std::abs(line[j] - original[j]));
+
+        std::cout << "DCT of length " << n << ": other wave numbers " << modeError << ", round trip " << roundTripError
+                  << ((modeError < 1e-12 && roundTripError < 1e-12) ? " ok" : " FAILED") << std::endl;
+    }
+}
+
 void test_staggered_grid(int rank, int nRanks)
 {
     int xl = 2;
@@ -218,9 +257,60 @@ void test_partitioning()
         PartitionInformation pi27_i(dim, meshWidth, i, 27);
 }
 
+void test_coarse_partitioning(int rank, int nRanks)
+{
+    // odd cell counts, so the local counts of some partitions are not divisible by the coarsening factor
+    std::array<int, 3> dim = {21, 15, 9};
+    std::array<double, 3> meshWidth = {0.1, 0.1, 0.1};
+    for(int coarseningFactor : {2, 3})
+    {
+        PartitionInformation fine(dim, meshWidth, rank, nRanks);
+        PartitionInformation coarse(fine, coarseningFactor);
+
+        // the expected coarse cells of each partition position, from the fine partitions of all ranks
+        std::array<std::vector<int>, 3> coarseCells;
+        for(int r = 0; r < nRanks; r++)
+        {
+            PartitionInformation other(dim, meshWidth, r, nRanks);
+            const std::array<int, 3> position{other.getPartPosX(), other.getPartPosY(), other.getPartPosZ()};
+            for(int d = 0; d < 3; d++)
+            {
+                if(position[d] >= (int)coarseCells[d].size())
+                    coarseCells[d].resize(position[d] + 1, 0);
+                coarseCells[d][position[d]] = (other.nCellsLocal()[d] + coarseningFactor - 1) / coarseningFactor;
+            }
+        }
+
+        const std::array<int, 3> position{fine.getPartPosX(), fine.getPartPosY(), fine.getPartPosZ()};
+        bool ok = coarse.leftRank() == fine.leftRank() && coarse.rightRank() == fine.rightRank()
+               && coarse.bottomRank() == fine.bottomRank() && coarse.topRank() == fine.topRank()
+               && coarse.frontRank() == fine.frontRank() && coarse.hindRank() == fine.hindRank();
+        for(int d = 0; d < 3; d++)
+        {
+            int offset = 0;
+            int global = 0;
+            for(int p = 0; p < (int)coarseCells[d].size(); p++)
+            {
+                if(p < position[d])
+                    offset += coarseCells[d][p];
+                global += coarseCells[d][p];
+            }
+            ok = ok && coarse.nCellsLocal()[d] == coarseCells[d][position[d]] && coarse.nodeOffset()[d] == offset
+                    && coarse.nCellsGlobal()[d] == global;
+        }
+
+        std::cout << "R:" << rank << " coarsened by " << coarseningFactor << ": " << coarse.nCellsLocal()[0] << "x"
+                  << coarse.nCellsLocal()[1] << "x" << coarse.nCellsLocal()[2] << " cells at (" << coarse.nodeOffset()[0]
+                  << "," << coarse.nodeOffset()[1] << "," << coarse.nodeOffset()[2] << ") of " << coarse.nCellsGlobal()[0]
+                  << "x" << coarse.nCellsGlobal()[1] << "x" << coarse.nCellsGlobal()[2] << (ok ? " ok" : " FAILED")
+                  << std::endl;
+    }
+}
+
 int main(int argc, char *argv[])
 {
-    MPI_Init(&argc, &argv);
+    int threadSupport;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &threadSupport);
     std::cout << "TEST!\n";
     // Get the number of processes
     int world_size;
@@ -231,9 +321,11 @@ int main(int argc, char *argv[])
     MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
 
     //test_field_variable();
+    test_dct();
     //test_staggered_grid(world_rank, world_size);
     //test_discretization(world_rank, world_size);
     //test_boundaries(world_rank, world_size);
     test_partitioning();
+    test_coarse_partitioning(world_rank, world_size);
     return 0;
 }
\ No newline at end of file